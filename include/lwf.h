@@ -44,6 +44,24 @@
 #define LWF_KMGMT_PSK     (1 << 2)
 #define LWF_KMGMT_COUNT   3
 
+#define LWF_SCAN_FLAG_LOW_PRIORITY (1 << 0)
+#define LWF_SCAN_FLAG_FLUSH        (1 << 1)
+#define LWF_SCAN_FLAG_AP           (1 << 2)
+
+#define LWF_SCAN_INFO_CHANNEL      (1 << 0)
+#define LWF_SCAN_INFO_LOAD         (1 << 1)
+#define LWF_SCAN_INFO_COUNTRY      (1 << 2)
+#define LWF_SCAN_INFO_RATES        (1 << 3)
+#define LWF_SCAN_INFO_CAPS         (1 << 4)
+#define LWF_SCAN_INFO_ALL          0x1f
+
+#define LWF_BSS_CAP_RRM            (1 << 0)
+#define LWF_BSS_CAP_BTM            (1 << 1)
+#define LWF_BSS_CAP_FT             (1 << 2)
+
+#define LWF_SCAN_MAX_FREQS	64
+#define LWF_SCAN_MAX_SSIDS	16
+
 #define LWF_AUTH_OPEN     (1 << 0)
 #define LWF_AUTH_SHARED   (1 << 1)
 #define LWF_AUTH_COUNT    2
@@ -114,17 +132,21 @@ struct lwf_assoclist_entry {
 	uint64_t rx_drop_misc;
 	struct lwf_rate_entry rx_rate;
 	struct lwf_rate_entry tx_rate;
-	uint32_t rx_bytes;
-	uint32_t tx_bytes;
+	uint64_t rx_bytes;
+	uint64_t tx_bytes;
 	uint32_t tx_retries;
 	uint32_t tx_failed;
 	uint64_t t_offset;
+	uint64_t rx_duration;
+	uint64_t tx_duration;
+	uint64_t beacon_rx;
 	uint8_t is_authorized:1;
 	uint8_t is_authenticated:1;
 	uint8_t is_preamble_short:1;
 	uint8_t is_wme:1;
 	uint8_t is_mfp:1;
 	uint8_t is_tdls:1;
+	uint8_t is_bytes64:1;
 	uint32_t thr;
 	uint16_t llid;
 	uint16_t plid;
@@ -176,6 +198,28 @@ struct lwf_scanlist_entry {
 	struct lwf_crypto_entry crypto;
 };
 
+/*
+ * Scan entry extended with details from the information elements. Only the
+ * LWF_SCAN_INFO_* groups set in info were decoded, fields the BSS does not
+ * advertise stay 0. The secondary channel offset is -1 below, 1 above or 0,
+ * the width is in MHz with 80+80 reported as 160, max_rate is the highest
+ * basic or extended rate in kbit/s and caps holds LWF_BSS_CAP_* for 802.11k
+ * radio measurement, 802.11v BSS transition and 802.11r fast transition.
+ */
+struct lwf_scanlist_entry_v2 {
+	struct lwf_scanlist_entry e;
+	uint32_t info;
+	uint8_t primary_channel;
+	int8_t secondary_offset;
+	uint16_t width;
+	uint16_t sta_count;
+	uint8_t utilization;
+	char country[3];
+	uint32_t max_rate;
+	uint8_t max_nss;
+	uint32_t caps;
+};
+
 struct lwf_country_entry {
 	uint16_t iso3166;
 	char ccode[4];
@@ -204,6 +248,99 @@ struct lwf_hardware_entry {
 	int16_t frequency_offset;
 };
 
+/*
+ * Statistics over all stations of an interface. Signal values are in dBm,
+ * the mean is taken over the received power in mW. Rates are in kbit/s.
+ * The signal fields are only valid if signal_count is non-zero.
+ */
+struct lwf_station_summary {
+	int count;
+	int signal_count;
+	int signal_mean;
+	int signal_min;
+	int signal_max;
+	int signal_median;
+	int tx_rate_mean;
+	int rx_rate_mean;
+};
+
+/*
+ * Restricts a triggered scan. Without frequencies all supported channels
+ * are scanned. Without SSIDs the scan is passive, each given SSID is probed
+ * for and an empty one sends a wildcard probe. The dwell time per channel
+ * is given in TU, 0 leaves it to the driver.
+ */
+struct lwf_scan_params {
+	uint32_t freqs[LWF_SCAN_MAX_FREQS];
+	int n_freqs;
+	char ssids[LWF_SCAN_MAX_SSIDS][LWF_ESSID_MAX_SIZE+1];
+	int n_ssids;
+	uint16_t duration;
+	uint32_t flags;
+};
+
+/*
+ * Interface state gathered in one go. Values which could not be determined
+ * are -1, except for signal and noise which are 0 and the strings which are
+ * left empty.
+ */
+struct lwf_iface_snapshot {
+	enum lwf_opmode mode;
+	int channel;
+	int frequency;
+	int txpower;
+	int bitrate;
+	int signal;
+	int noise;
+	int quality;
+	int quality_max;
+	char ssid[LWF_ESSID_MAX_SIZE+1];
+	char bssid[18];
+};
+
+/*
+ * Result buffer for the list ops. With grow set, the buffer is (re)allocated
+ * as needed and must be released with lwf_buf_free(). Otherwise at most size
+ * bytes are written and the op fails with -ENOSPC, leaving the required size
+ * in len.
+ */
+struct lwf_buf {
+	char *buf;
+	int size;
+	int len;
+	int grow;
+};
+
+enum lwf_list_type {
+	LWF_LIST_ASSOC,
+	LWF_LIST_SCAN,
+	LWF_LIST_FREQ,
+	LWF_LIST_SURVEY,
+	LWF_LIST_TXPWR,
+	LWF_LIST_COUNTRY,
+	LWF_LIST_ASSOC_WATCHED,
+};
+
+enum lwf_station_notify_type {
+	LWF_STATION_NOTIFY_NEW,
+	LWF_STATION_NOTIFY_DEL,
+	LWF_STATION_NOTIFY_CONN_FAILED,
+	LWF_STATION_NOTIFY_DISCONNECT,
+};
+
+/*
+ * Station notification delivered to lwf_station_watch() callbacks. The
+ * reason is the CONN_FAILED reason or the 802.11 reason code of a
+ * disconnect, entry is only set for new stations.
+ */
+struct lwf_station_notify {
+	enum lwf_station_notify_type type;
+	char ifname[IFNAMSIZ];
+	uint8_t mac[6];
+	uint32_t reason;
+	const struct lwf_assoclist_entry *entry;
+};
+
 extern const struct lwf_iso3166_label LWF_ISO3166_NAMES[];
 
 #define LWF_HARDWARE_FILE	"/usr/share/liblwf/hardware.txt"
@@ -241,14 +378,193 @@ struct lwf_ops {
 	int (*countrylist)(const char *, char *, int *);
 	int (*survey)(const char *, char *, int *);
 	int (*lookup_phy)(const char *, char *);
+	int (*snapshot)(const char *, struct lwf_iface_snapshot *);
+	int (*snapshots)(const char **, int, struct lwf_iface_snapshot *);
+	int (*list)(const char *, enum lwf_list_type, struct lwf_buf *);
+	int (*scanlist_cached)(const char *, int, struct lwf_buf *);
+	int (*scanlist_params)(const char *, const struct lwf_scan_params *,
+		struct lwf_buf *);
+	int (*scanlist_v2)(const char *, const struct lwf_scan_params *,
+		uint32_t, struct lwf_buf *);
+	int (*station_foreach)(const char *,
+		int (*)(const struct lwf_assoclist_entry *, void *), void *);
+	int (*station_get)(const char *, const uint8_t *,
+		struct lwf_assoclist_entry *);
+	int (*station_summary)(const char *, struct lwf_station_summary *);
+	int (*station_watch)(const char *,
+		void (*)(const struct lwf_station_notify *, void *), void *);
+	int (*station_unwatch)(const char *);
+	int (*dispatch)(void);
+	int (*async_fd)(void);
+	int (*async_list)(const char *, enum lwf_list_type, struct lwf_buf *,
+		void (*)(int, struct lwf_buf *, void *), void *);
+	int (*async_process)(void);
+	void * (*scan_start)(const char *, const struct lwf_scan_params *, int,
+		void (*)(const struct lwf_scanlist_entry *, void *), void *);
+	int (*scan_fd)(void);
+	int (*scan_poll)(void *);
+	void (*scan_free)(void *);
 	void (*close)(void);
 };
 
+/*
+ * Backend sockets and caches live in a library context. Each thread works
+ * on its own default context, an explicit one can be created and made
+ * current for the calling thread with lwf_ctx_use(), which returns the
+ * previously current context. Passing NULL selects the default again.
+ */
+struct lwf_ctx;
+
+struct lwf_ctx * lwf_ctx_new(void);
+struct lwf_ctx * lwf_ctx_use(struct lwf_ctx *ctx);
+void lwf_ctx_free(struct lwf_ctx *ctx);
+
+/*
+ * Blocking requests of the current context fail with -ETIMEDOUT once
+ * timeout milliseconds have passed, 0 restores the default and a negative
+ * value waits forever. While waiting the cancel hook is polled, a non-zero
+ * return aborts the request with -ECANCELED.
+ */
+#define LWF_DEFAULT_TIMEOUT	5000
+
+void lwf_set_timeout(int timeout);
+void lwf_set_cancel(int (*cancel)(void *arg), void *arg);
+
 const char * lwf_type(const char *ifname);
 const struct lwf_ops * lwf_backend(const char *ifname);
 const struct lwf_ops * lwf_backend_by_name(const char *name);
 void lwf_finish(void);
 
+int lwf_list(const struct lwf_ops *iw, const char *ifname,
+             enum lwf_list_type type, struct lwf_buf *b);
+
+/*
+ * Read the scan results the kernel still holds for ifname without
+ * triggering a new scan. Entries last seen more than max_age milliseconds
+ * ago are skipped, a negative max_age returns all of them.
+ */
+int lwf_scanlist_cached(const char *ifname, int max_age, struct lwf_buf *b);
+
+/* Trigger a scan restricted by p and collect its results, p may be NULL */
+int lwf_scanlist_params(const char *ifname, const struct lwf_scan_params *p,
+                        struct lwf_buf *b);
+
+/*
+ * Like lwf_scanlist_params() but fills b with lwf_scanlist_entry_v2 records,
+ * decoding the LWF_SCAN_INFO_* groups given in info.
+ */
+int lwf_scanlist_v2(const char *ifname, const struct lwf_scan_params *p,
+                    uint32_t info, struct lwf_buf *b);
+
+/*
+ * Invoke cb for each station associated to ifname as the entries arrive,
+ * without collecting the whole table first. A non-zero return value from
+ * cb stops the iteration. cb runs while the dump is still being received
+ * and must not call back into the library, such calls fail. Neither may it
+ * leave by longjmp().
+ */
+int lwf_station_foreach(const char *ifname,
+	int (*cb)(const struct lwf_assoclist_entry *e, void *ctx), void *ctx);
+
+/*
+ * Query a single station of ifname by MAC address without dumping the
+ * whole table. The noise field is not filled in. Returns -ENOENT if the
+ * station is not associated.
+ */
+int lwf_station_get(const char *ifname, const uint8_t *mac,
+                    struct lwf_assoclist_entry *e);
+
+/*
+ * Aggregate signal and rate statistics over the stations of ifname. The
+ * backend may serve the result from a cache that is at most a second old.
+ */
+int lwf_station_summary(const char *ifname, struct lwf_station_summary *s);
+
+
+enum lwf_station_event {
+	LWF_STATION_ADDED,
+	LWF_STATION_CHANGED,
+	LWF_STATION_REMOVED,
+};
+
+/*
+ * Change of a single station between two tracker polls. The rates are per
+ * second over interval and only set for LWF_STATION_CHANGED.
+ */
+struct lwf_station_delta {
+	enum lwf_station_event event;
+	const struct lwf_assoclist_entry *entry;
+	double interval;
+	double rx_bytes;
+	double tx_bytes;
+	double rx_packets;
+	double tx_packets;
+	double tx_retries;
+	double tx_failed;
+};
+
+/*
+ * Track the stations of ifname (and its ifname.staX WDS interfaces) from
+ * nl80211 multicast events instead of polling. cb is invoked from within
+ * lwf_dispatch() only, for every new, deleted, rejected or disconnected
+ * station. Returns a descriptor which becomes readable when lwf_dispatch()
+ * has work to do. The station table maintained from the events is
+ * available as LWF_LIST_ASSOC_WATCHED.
+ */
+int lwf_station_watch(const char *ifname,
+	void (*cb)(const struct lwf_station_notify *n, void *ctx), void *ctx);
+int lwf_station_unwatch(const char *ifname);
+int lwf_dispatch(void);
+
+/*
+ * Non-blocking list requests. lwf_async_fd() returns a descriptor to add to
+ * the caller's event loop; whenever it is readable lwf_async_process() must
+ * be called, which invokes the done callback of each request completed so
+ * far with 0 or a negative error. Lists which need no kernel round trip are
+ * completed before lwf_async_list() returns. Requests failing with -EAGAIN
+ * were lost when the socket had to be replaced after a timed out dump, the
+ * descriptor must then be fetched again.
+ */
+int lwf_async_fd(const struct lwf_ops *iw);
+int lwf_async_list(const struct lwf_ops *iw, const char *ifname,
+	enum lwf_list_type type, struct lwf_buf *b,
+	void (*done)(int err, struct lwf_buf *b, void *ctx), void *ctx);
+int lwf_async_process(const struct lwf_ops *iw);
+
+/*
+ * Non-blocking scans. lwf_scan_start() triggers a scan, restricted by p if
+ * not NULL, and returns at once. The timeout is given in milliseconds with
+ * 0 selecting the backend default and a negative value never expiring.
+ * Whenever lwf_scan_fd() is readable, or periodically to enforce the
+ * timeout, lwf_scan_poll() must be called: it returns 0 while the scan runs
+ * and 1 once every result was passed to cb, or a negative error such as
+ * -ETIMEDOUT after which the scan was aborted. -EBUSY is returned if the
+ * radio stayed busy with something other than a scan which could be
+ * shared. Several scans on different radios may run at the same time.
+ * cb is invoked from lwf_scan_poll() while the result dump is received and
+ * must neither call back into the library, such calls fail, nor longjmp().
+ */
+struct lwf_scan;
+
+struct lwf_scan * lwf_scan_start(const char *ifname,
+	const struct lwf_scan_params *p, int timeout,
+	void (*cb)(const struct lwf_scanlist_entry *e, void *ctx), void *ctx);
+int lwf_scan_fd(struct lwf_scan *s);
+int lwf_scan_poll(struct lwf_scan *s);
+void lwf_scan_free(struct lwf_scan *s);
+
+struct lwf_station_tracker;
+
+struct lwf_station_tracker * lwf_station_tracker_new(const char *ifname);
+void lwf_station_tracker_free(struct lwf_station_tracker *t);
+
+/*
+ * Dump the stations of the tracked interface and report those which were
+ * added, whose counters changed or which went away since the last poll.
+ */
+int lwf_station_tracker_poll(struct lwf_station_tracker *t,
+	void (*cb)(const struct lwf_station_delta *d, void *ctx), void *ctx);
+
 extern const struct lwf_ops nl80211_ops;
 
 
@@ -27,6 +27,8 @@
 
 
 #define LWF_META			"lwf"
+#define LWF_TRACKER_META	"lwf.tracker"
+#define LWF_COUNTER_META	"lwf.counter"
 
 #ifdef USE_NL80211
 #define LWF_NL80211_META	"lwf.nl80211"
@@ -67,4 +69,10 @@
 		return lwf_L_##op(L, type##_ops.op);			\
 	}
 
+#define LUA_WRAP_LIST_OP(type,op)						\
+	static int lwf_L_##type##_##op(lua_State *L)		\
+	{													\
+		return lwf_L_##op(L, &type##_ops);				\
+	}
+
 #endif
@@ -45,6 +45,46 @@ int lwf_ifmac(const char *ifname);
 
 void lwf_close(void);
 
+struct nl80211_state;
+struct nl80211_hw_node;
+
+struct lwf_ctx {
+	struct nl80211_state *nl80211;
+	struct nl80211_hw_node *nl80211_hw;
+	int timeout;
+	int (*cancel)(void *);
+	void *cancel_arg;
+};
+
+/* request timeout in ms of the current context, negative means none */
+int lwf_ctx_timeout(void);
+int lwf_ctx_cancelled(void);
+
+struct lwf_ctx * lwf_ctx_get(void);
+
+/*
+ * Accumulates a free running hardware counter of the given width into a
+ * 64 bit total, so that wraps between two samples are not lost.
+ */
+struct lwf_counter {
+	uint64_t total;
+	uint64_t last;
+	uint8_t bits;
+	uint8_t valid;
+};
+
+static inline uint64_t lwf_counter_delta(uint64_t prev, uint64_t cur, int bits)
+{
+	uint64_t d = cur - prev;
+
+	return (bits < 64) ? (d & ((1ULL << bits) - 1)) : d;
+}
+
+uint64_t lwf_counter_update(struct lwf_counter *c, uint64_t sample);
+
+void * lwf_buf_add(struct lwf_buf *b, int len);
+void lwf_buf_free(struct lwf_buf *b);
+
 struct lwf_hardware_entry * lwf_hardware(struct lwf_hardware_id *id);
 
 int lwf_hardware_id_from_mtd(struct lwf_hardware_id *id);
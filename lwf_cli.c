@@ -17,12 +17,16 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <glob.h>
 
 #include "lwf.h"
 
+/* "lastscan" lists kernel results seen within this many ms */
+#define SCAN_CACHE_MAX_AGE	30000
 
-static char * format_bssid(unsigned char *mac)
+static char * format_bssid(const unsigned char *mac)
 {
 	static char buf[18];
 
@@ -263,7 +267,7 @@ static char * format_hwmodes(int modes)
 	return buf;
 }
 
-static char * format_assocrate(struct lwf_rate_entry *r)
+static char * format_assocrate(const struct lwf_rate_entry *r)
 {
 	static char buf[80];
 	char *p = buf;
@@ -356,122 +360,54 @@ static char * print_frequency_offset(const struct lwf_ops *iw, const char *ifnam
 	return buf;
 }
 
-static char * print_ssid(const struct lwf_ops *iw, const char *ifname)
+static void get_snapshot(const struct lwf_ops *iw, const char *ifname,
+                         struct lwf_iface_snapshot *s)
 {
-	char buf[LWF_ESSID_MAX_SIZE + 1] = { 0 };
-
-	if (iw->ssid(ifname, buf))
-		memset(buf, 0, sizeof(buf));
-
-	return format_ssid(buf);
-}
-
-static char * print_bssid(const struct lwf_ops *iw, const char *ifname)
-{
-	static char buf[18] = { 0 };
-
-	if (iw->bssid(ifname, buf))
-		snprintf(buf, sizeof(buf), "00:00:00:00:00:00");
-
-	return buf;
-}
-
-static char * print_mode(const struct lwf_ops *iw, const char *ifname)
-{
-	int mode;
-	static char buf[128];
-
-	if (iw->mode(ifname, &mode))
-		mode = LWF_OPMODE_UNKNOWN;
-
-	snprintf(buf, sizeof(buf), "%s", LWF_OPMODE_NAMES[mode]);
-
-	return buf;
-}
-
-static char * print_channel(const struct lwf_ops *iw, const char *ifname)
-{
-	int ch;
-
-	if (iw->channel(ifname, &ch))
-		ch = -1;
-
-	return format_channel(ch);
-}
-
-static char * print_frequency(const struct lwf_ops *iw, const char *ifname)
-{
-	int freq;
-
-	if (iw->frequency(ifname, &freq))
-		freq = -1;
-
-	return format_frequency(freq);
-}
-
-static char * print_txpower(const struct lwf_ops *iw, const char *ifname)
-{
-	int pwr, off;
-
-	if (iw->txpower_offset(ifname, &off))
-		off = 0;
-
-	if (iw->txpower(ifname, &pwr))
-		pwr = -1;
-	else
-		pwr += off;
-
-	return format_txpower(pwr);
-}
+	int off;
 
-static char * print_quality(const struct lwf_ops *iw, const char *ifname)
-{
-	int qual;
+	if (!iw->snapshot || iw->snapshot(ifname, s))
+	{
+		memset(s, 0, sizeof(*s));
 
-	if (iw->quality(ifname, &qual))
-		qual = -1;
+		if (iw->ssid(ifname, s->ssid))
+			memset(s->ssid, 0, sizeof(s->ssid));
 
-	return format_quality(qual);
-}
+		if (iw->bssid(ifname, s->bssid))
+			memset(s->bssid, 0, sizeof(s->bssid));
 
-static char * print_quality_max(const struct lwf_ops *iw, const char *ifname)
-{
-	int qmax;
+		if (iw->mode(ifname, (int *)&s->mode))
+			s->mode = LWF_OPMODE_UNKNOWN;
 
-	if (iw->quality_max(ifname, &qmax))
-		qmax = -1;
+		if (iw->channel(ifname, &s->channel))
+			s->channel = -1;
 
-	return format_quality_max(qmax);
-}
+		if (iw->frequency(ifname, &s->frequency))
+			s->frequency = -1;
 
-static char * print_signal(const struct lwf_ops *iw, const char *ifname)
-{
-	int sig;
+		if (iw->txpower(ifname, &s->txpower))
+			s->txpower = -1;
 
-	if (iw->signal(ifname, &sig))
-		sig = 0;
+		if (iw->quality(ifname, &s->quality))
+			s->quality = -1;
 
-	return format_signal(sig);
-}
-
-static char * print_noise(const struct lwf_ops *iw, const char *ifname)
-{
-	int noise;
+		if (iw->quality_max(ifname, &s->quality_max))
+			s->quality_max = -1;
 
-	if (iw->noise(ifname, &noise))
-		noise = 0;
+		if (iw->signal(ifname, &s->signal))
+			s->signal = 0;
 
-	return format_noise(noise);
-}
+		if (iw->noise(ifname, &s->noise))
+			s->noise = 0;
 
-static char * print_rate(const struct lwf_ops *iw, const char *ifname)
-{
-	int rate;
+		if (iw->bitrate(ifname, &s->bitrate))
+			s->bitrate = -1;
+	}
 
-	if (iw->bitrate(ifname, &rate))
-		rate = -1;
+	if (s->txpower >= 0 && !iw->txpower_offset(ifname, &off))
+		s->txpower += off;
 
-	return format_rate(rate);
+	if (!s->bssid[0])
+		snprintf(s->bssid, sizeof(s->bssid), "00:00:00:00:00:00");
 }
 
 static char * print_encryption(const struct lwf_ops *iw, const char *ifname)
@@ -520,24 +456,28 @@ static char * print_phyname(const struct lwf_ops *iw, const char *ifname)
 
 static void print_info(const struct lwf_ops *iw, const char *ifname)
 {
+	struct lwf_iface_snapshot s;
+
+	get_snapshot(iw, ifname, &s);
+
 	printf("%-9s ESSID: %s\n",
 	       ifname,
-	       print_ssid(iw, ifname));
+	       format_ssid(s.ssid));
 	printf("          Access Point: %s\n",
-	       print_bssid(iw, ifname));
+	       s.bssid);
 	printf("          Mode: %s  Channel: %s (%s)\n",
-	       print_mode(iw, ifname),
-	       print_channel(iw, ifname),
-	       print_frequency(iw, ifname));
+	       LWF_OPMODE_NAMES[s.mode],
+	       format_channel(s.channel),
+	       format_frequency(s.frequency));
 	printf("          Tx-Power: %s  Link Quality: %s/%s\n",
-	       print_txpower(iw, ifname),
-	       print_quality(iw, ifname),
-	       print_quality_max(iw, ifname));
+	       format_txpower(s.txpower),
+	       format_quality(s.quality),
+	       format_quality_max(s.quality_max));
 	printf("          Signal: %s  Noise: %s\n",
-	       print_signal(iw, ifname),
-	       print_noise(iw, ifname));
+	       format_signal(s.signal),
+	       format_noise(s.noise));
 	printf("          Bit Rate: %s\n",
-	       print_rate(iw, ifname));
+	       format_rate(s.bitrate));
 	printf("          Encryption: %s\n",
 	       print_encryption(iw, ifname));
 	printf("          Type: %s  HW Mode(s): %s\n",
@@ -556,22 +496,72 @@ static void print_info(const struct lwf_ops *iw, const char *ifname)
 }
 
 
-static void print_scanlist(const struct lwf_ops *iw, const char *ifname)
+/* Consume scan options following the scan command, returns their count */
+static int parse_scan_params(int argc, char **argv, struct lwf_scan_params *p)
 {
-	int i, x, len;
-	char buf[LWF_BUFSIZE];
+	int n;
+	char *s, *e;
+
+	memset(p, 0, sizeof(*p));
+
+	for (n = 0; n < argc; n++) {
+		if (!strncmp(argv[n], "freq=", 5)) {
+			for (s = argv[n] + 5; p->n_freqs < LWF_SCAN_MAX_FREQS; s = e + 1) {
+				p->freqs[p->n_freqs] = strtoul(s, &e, 10);
+
+				if (e == s)
+					break;
+
+				p->n_freqs++;
+
+				if (*e != ',')
+					break;
+			}
+		} else if (!strncmp(argv[n], "ssid=", 5)) {
+			if (p->n_ssids < LWF_SCAN_MAX_SSIDS)
+				strncpy(p->ssids[p->n_ssids++], argv[n] + 5,
+				        LWF_ESSID_MAX_SIZE);
+		} else if (!strncmp(argv[n], "dwell=", 6)) {
+			p->duration = atoi(argv[n] + 6);
+		} else if (!strcmp(argv[n], "flush")) {
+			p->flags |= LWF_SCAN_FLAG_FLUSH;
+		} else if (!strcmp(argv[n], "lowprio")) {
+			p->flags |= LWF_SCAN_FLAG_LOW_PRIORITY;
+		} else if (!strcmp(argv[n], "ap")) {
+			p->flags |= LWF_SCAN_FLAG_AP;
+		} else {
+			break;
+		}
+	}
+
+	return n;
+}
+
+static void print_scanlist(const struct lwf_ops *iw, const char *ifname,
+                           const struct lwf_scan_params *p, int cached)
+{
+	int i, x, rv;
+	struct lwf_buf b = { .grow = 1 };
 	struct lwf_scanlist_entry *e;
 
-	if (iw->scanlist(ifname, buf, &len)) {
+	if (cached)
+		rv = iw->scanlist_cached ?
+			iw->scanlist_cached(ifname, SCAN_CACHE_MAX_AGE, &b) : -1;
+	else if (p)
+		rv = iw->scanlist_params ? iw->scanlist_params(ifname, p, &b) : -1;
+	else
+		rv = lwf_list(iw, ifname, LWF_LIST_SCAN, &b);
+
+	if (rv) {
 		printf("Scanning not possible\n\n");
-		return;
-	} else if (len <= 0) {
+		goto out;
+	} else if (b.len <= 0) {
 		printf("No scan results\n\n");
-		return;
+		goto out;
 	}
 
-	for (i = 0, x = 1; i < len; i += sizeof(struct lwf_scanlist_entry), x++) {
-		e = (struct lwf_scanlist_entry *)&buf[i];
+	for (i = 0, x = 1; i < b.len; i += sizeof(struct lwf_scanlist_entry), x++) {
+		e = (struct lwf_scanlist_entry *)&b.buf[i];
 
 		printf("Cell %02d - Address: %s\n",
 		       x,
@@ -588,18 +578,21 @@ static void print_scanlist(const struct lwf_ops *iw, const char *ifname)
 		printf("          Encryption: %s\n\n",
 		       format_encryption(&e->crypto));
 	}
+
+out:
+	lwf_buf_free(&b);
 }
 
 
 static void print_txpwrlist(const struct lwf_ops *iw, const char *ifname)
 {
-	int len, pwr, off, i;
-	char buf[LWF_BUFSIZE];
+	int pwr, off, i;
+	struct lwf_buf b = { .grow = 1 };
 	struct lwf_txpwrlist_entry *e;
 
-	if (iw->txpwrlist(ifname, buf, &len) || len <= 0) {
+	if (lwf_list(iw, ifname, LWF_LIST_TXPWR, &b) || b.len <= 0) {
 		printf("No TX power information available\n");
-		return;
+		goto out;
 	}
 
 	if (iw->txpower(ifname, &pwr))
@@ -608,33 +601,36 @@ static void print_txpwrlist(const struct lwf_ops *iw, const char *ifname)
 	if (iw->txpower_offset(ifname, &off))
 		off = 0;
 
-	for (i = 0; i < len; i += sizeof(struct lwf_txpwrlist_entry)) {
-		e = (struct lwf_txpwrlist_entry *)&buf[i];
+	for (i = 0; i < b.len; i += sizeof(struct lwf_txpwrlist_entry)) {
+		e = (struct lwf_txpwrlist_entry *)&b.buf[i];
 
 		printf("%s%3d dBm (%4d mW)\n",
 		       (pwr == e->dbm) ? "*" : " ",
 		       e->dbm + off,
 		       lwf_dbm2mw(e->dbm + off));
 	}
+
+out:
+	lwf_buf_free(&b);
 }
 
 
 static void print_freqlist(const struct lwf_ops *iw, const char *ifname)
 {
-	int i, len, ch;
-	char buf[LWF_BUFSIZE];
+	int i, ch;
+	struct lwf_buf b = { .grow = 1 };
 	struct lwf_freqlist_entry *e;
 
-	if (iw->freqlist(ifname, buf, &len) || len <= 0) {
+	if (lwf_list(iw, ifname, LWF_LIST_FREQ, &b) || b.len <= 0) {
 		printf("No frequency information available\n");
-		return;
+		goto out;
 	}
 
 	if (iw->channel(ifname, &ch))
 		ch = -1;
 
-	for (i = 0; i < len; i += sizeof(struct lwf_freqlist_entry)) {
-		e = (struct lwf_freqlist_entry *)&buf[i];
+	for (i = 0; i < b.len; i += sizeof(struct lwf_freqlist_entry)) {
+		e = (struct lwf_freqlist_entry *)&b.buf[i];
 
 		printf("%s %s (Channel %s)%s\n",
 		       (ch == e->channel) ? "*" : " ",
@@ -642,46 +638,67 @@ static void print_freqlist(const struct lwf_ops *iw, const char *ifname)
 		       format_channel(e->channel),
 		       e->restricted ? " [restricted]" : "");
 	}
+
+out:
+	lwf_buf_free(&b);
 }
 
 
-static void print_assoclist(const struct lwf_ops *iw, const char *ifname)
+static int print_assoclist_cb(const struct lwf_assoclist_entry *e, void *ctx)
 {
-	int i, len;
-	char buf[LWF_BUFSIZE];
-	struct lwf_assoclist_entry *e;
+	int *count = ctx;
 
-	if (iw->assoclist(ifname, buf, &len)) {
-		printf("No information available\n");
-		return;
-	} else if (len <= 0) {
-		printf("No station connected\n");
-		return;
-	}
+	printf("%s  %s / %s (SNR %d)  %d ms ago\n",
+	       format_bssid(e->mac),
+	       format_signal(e->signal),
+	       format_noise(e->noise),
+	       (e->signal - e->noise),
+	       e->inactive);
+
+	printf("	RX: %-38s  %8d Pkts.  %12llu Bytes\n",
+	       format_assocrate(&e->rx_rate),
+	       e->rx_packets,
+	       (unsigned long long)e->rx_bytes
+	       );
 
-	for (i = 0; i < len; i += sizeof(struct lwf_assoclist_entry)) {
-		e = (struct lwf_assoclist_entry *)&buf[i];
+	printf("	TX: %-38s  %8d Pkts.  %12llu Bytes\n",
+	       format_assocrate(&e->tx_rate),
+	       e->tx_packets,
+	       (unsigned long long)e->tx_bytes
+	       );
 
-		printf("%s  %s / %s (SNR %d)  %d ms ago\n",
-		       format_bssid(e->mac),
-		       format_signal(e->signal),
-		       format_noise(e->noise),
-		       (e->signal - e->noise),
-		       e->inactive);
+	printf("	expected throughput: %s\n\n",
+	       format_rate(e->thr));
 
-		printf("	RX: %-38s  %8d Pkts.\n",
-		       format_assocrate(&e->rx_rate),
-		       e->rx_packets
-		       );
+	(*count)++;
+	return 0;
+}
 
-		printf("	TX: %-38s  %8d Pkts.\n",
-		       format_assocrate(&e->tx_rate),
-		       e->tx_packets
-		       );
+static void print_assoclist(const struct lwf_ops *iw, const char *ifname)
+{
+	int i, count = 0;
+	struct lwf_buf b = { .grow = 1 };
 
-		printf("	expected throughput: %s\n\n",
-		       format_rate(e->thr));
+	if (iw->station_foreach) {
+		if (iw->station_foreach(ifname, print_assoclist_cb, &count)) {
+			printf("No information available\n");
+			return;
+		}
+	} else {
+		if (lwf_list(iw, ifname, LWF_LIST_ASSOC, &b)) {
+			printf("No information available\n");
+			goto out;
+		}
+
+		for (i = 0; i < b.len; i += sizeof(struct lwf_assoclist_entry))
+			print_assoclist_cb((struct lwf_assoclist_entry *)&b.buf[i], &count);
 	}
+
+	if (count <= 0)
+		printf("No station connected\n");
+
+out:
+	lwf_buf_free(&b);
 }
 
 
@@ -702,27 +719,29 @@ static char * lookup_country(char *buf, int len, int iso3166)
 
 static void print_countrylist(const struct lwf_ops *iw, const char *ifname)
 {
-	int len;
-	char buf[LWF_BUFSIZE];
+	struct lwf_buf b = { .grow = 1 };
 	char *ccode;
 	char curcode[3];
 	const struct lwf_iso3166_label *l;
 
-	if (iw->countrylist(ifname, buf, &len)) {
+	if (lwf_list(iw, ifname, LWF_LIST_COUNTRY, &b)) {
 		printf("No country code information available\n");
-		return;
+		goto out;
 	}
 
 	if (iw->country(ifname, curcode))
 		memset(curcode, 0, sizeof(curcode));
 
 	for (l = LWF_ISO3166_NAMES; l->iso3166; l++) {
-		if ((ccode = lookup_country(buf, len, l->iso3166)) != NULL) {
+		if ((ccode = lookup_country(b.buf, b.len, l->iso3166)) != NULL) {
 			printf("%s %4s	%c%c\n",
 			       strncmp(ccode, curcode, 2) ? " " : "*",
 			       ccode, (l->iso3166 / 256), (l->iso3166 % 256));
 		}
 	}
+
+out:
+	lwf_buf_free(&b);
 }
 
 static void print_htmodelist(const struct lwf_ops *iw, const char *ifname)
@@ -761,16 +780,19 @@ static void lookup_phy(const struct lwf_ops *iw, const char *section)
 
 int main(int argc, char **argv)
 {
-	int i, rv = 0;
+	int i, n, rv = 0;
 	char *p;
 	const struct lwf_ops *iw;
+	struct lwf_scan_params params;
 	glob_t globbuf;
 
 	if (argc > 1 && argc < 3) {
 		fprintf(stderr,
 			"Usage:\n"
 			"	lwf <device> info\n"
-			"	lwf <device> scan\n"
+			"	lwf <device> scan [freq=<mhz>[,<mhz>...]] [ssid=<ssid>]\n"
+			"	                  [dwell=<tu>] [flush] [lowprio] [ap]\n"
+			"	lwf <device> lastscan\n"
 			"	lwf <device> txpowerlist\n"
 			"	lwf <device> freqlist\n"
 			"	lwf <device> assoclist\n"
@@ -804,7 +826,8 @@ int main(int argc, char **argv)
 		return 0;
 	}
 
-	if (argc > 3) {
+	/* "<backend> phyname <section>", everything else names a device */
+	if (argc > 3 && argv[2][0] == 'p') {
 		iw = lwf_backend_by_name(argv[1]);
 
 		if (!iw) {
@@ -835,7 +858,13 @@ int main(int argc, char **argv)
 					break;
 
 				case 's':
-					print_scanlist(iw, argv[1]);
+					n = parse_scan_params(argc - i - 1, &argv[i + 1], &params);
+					print_scanlist(iw, argv[1], n ? &params : NULL, 0);
+					i += n;
+					break;
+
+				case 'l':
+					print_scanlist(iw, argv[1], NULL, 1);
 					break;
 
 				case 't':
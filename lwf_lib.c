@@ -16,6 +16,9 @@
  * with the lwf library. If not, see http://www.gnu.org/licenses/.
  */
 
+#include <time.h>
+#include <pthread.h>
+
 #include "lwf.h"
 
 
@@ -329,6 +332,103 @@ static const struct lwf_ops *backends[] = {
 #endif
 };
 
+static __thread struct lwf_ctx lwf_ctx_default;
+static __thread struct lwf_ctx *lwf_ctx_current;
+static __thread int lwf_ctx_registered;
+
+static pthread_key_t lwf_ctx_key;
+static pthread_once_t lwf_ctx_once = PTHREAD_ONCE_INIT;
+
+/* Release the sockets of the default context when its thread exits */
+static void lwf_ctx_exit(void *arg)
+{
+	int i;
+
+	lwf_ctx_current = NULL;
+
+	for (i = 0; i < ARRAY_SIZE(backends); i++)
+		backends[i]->close();
+
+	lwf_close();
+}
+
+static void lwf_ctx_key_init(void)
+{
+	pthread_key_create(&lwf_ctx_key, lwf_ctx_exit);
+}
+
+struct lwf_ctx * lwf_ctx_get(void)
+{
+	if (lwf_ctx_current)
+		return lwf_ctx_current;
+
+	if (!lwf_ctx_registered)
+	{
+		lwf_ctx_registered = 1;
+		pthread_once(&lwf_ctx_once, lwf_ctx_key_init);
+		pthread_setspecific(lwf_ctx_key, &lwf_ctx_default);
+	}
+
+	return &lwf_ctx_default;
+}
+
+struct lwf_ctx * lwf_ctx_new(void)
+{
+	return calloc(1, sizeof(struct lwf_ctx));
+}
+
+struct lwf_ctx * lwf_ctx_use(struct lwf_ctx *ctx)
+{
+	struct lwf_ctx *prev = lwf_ctx_current;
+
+	lwf_ctx_current = ctx;
+	return prev;
+}
+
+void lwf_ctx_free(struct lwf_ctx *ctx)
+{
+	struct lwf_ctx *prev;
+	int i;
+
+	if (!ctx)
+		return;
+
+	prev = lwf_ctx_use(ctx);
+
+	for (i = 0; i < ARRAY_SIZE(backends); i++)
+		backends[i]->close();
+
+	lwf_ctx_use((prev != ctx) ? prev : NULL);
+	free(ctx);
+}
+
+void lwf_set_timeout(int timeout)
+{
+	lwf_ctx_get()->timeout = timeout;
+}
+
+void lwf_set_cancel(int (*cancel)(void *arg), void *arg)
+{
+	struct lwf_ctx *ctx = lwf_ctx_get();
+
+	ctx->cancel = cancel;
+	ctx->cancel_arg = arg;
+}
+
+int lwf_ctx_timeout(void)
+{
+	struct lwf_ctx *ctx = lwf_ctx_get();
+
+	return ctx->timeout ? ctx->timeout : LWF_DEFAULT_TIMEOUT;
+}
+
+int lwf_ctx_cancelled(void)
+{
+	struct lwf_ctx *ctx = lwf_ctx_get();
+
+	return ctx->cancel ? ctx->cancel(ctx->cancel_arg) : 0;
+}
+
 const char * lwf_type(const char *ifname)
 {
 	const struct lwf_ops *ops = lwf_backend(ifname);
@@ -360,6 +460,465 @@ const struct lwf_ops * lwf_backend_by_name(const char *name)
 	return NULL;
 }
 
+int lwf_list(const struct lwf_ops *iw, const char *ifname,
+             enum lwf_list_type type, struct lwf_buf *b)
+{
+	int rv, len = 0;
+	char *p;
+	int (*func)(const char *, char *, int *) = NULL;
+
+	if (iw->list)
+		return iw->list(ifname, type, b);
+
+	switch (type)
+	{
+	case LWF_LIST_ASSOC:   func = iw->assoclist;   break;
+	case LWF_LIST_SCAN:    func = iw->scanlist;    break;
+	case LWF_LIST_FREQ:    func = iw->freqlist;    break;
+	case LWF_LIST_SURVEY:  func = iw->survey;      break;
+	case LWF_LIST_TXPWR:   func = iw->txpwrlist;   break;
+	case LWF_LIST_COUNTRY: func = iw->countrylist; break;
+	default:               break;
+	}
+
+	if (!func)
+		return -EOPNOTSUPP;
+
+	/* backends without a list op expect a LWF_BUFSIZE sized buffer */
+	if (b->size < LWF_BUFSIZE)
+	{
+		b->len = LWF_BUFSIZE;
+
+		if (!b->grow)
+			return -ENOSPC;
+
+		if (!(p = realloc(b->buf, LWF_BUFSIZE)))
+			return -ENOMEM;
+
+		b->buf = p;
+		b->size = LWF_BUFSIZE;
+	}
+
+	rv = func(ifname, b->buf, &len);
+	b->len = rv ? 0 : len;
+
+	return rv;
+}
+
+static int station_foreach(const struct lwf_ops *iw, const char *ifname,
+	int (*cb)(const struct lwf_assoclist_entry *e, void *ctx), void *ctx)
+{
+	int i, rv;
+	struct lwf_buf b = { .grow = 1 };
+
+	if (iw->station_foreach)
+		return iw->station_foreach(ifname, cb, ctx);
+
+	if ((rv = lwf_list(iw, ifname, LWF_LIST_ASSOC, &b)) != 0)
+		goto out;
+
+	for (i = 0; i < b.len; i += sizeof(struct lwf_assoclist_entry))
+		if (cb((struct lwf_assoclist_entry *)&b.buf[i], ctx))
+			break;
+
+out:
+	lwf_buf_free(&b);
+	return rv;
+}
+
+int lwf_station_foreach(const char *ifname,
+	int (*cb)(const struct lwf_assoclist_entry *e, void *ctx), void *ctx)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	return station_foreach(iw, ifname, cb, ctx);
+}
+
+struct station_get_ctx {
+	const uint8_t *mac;
+	struct lwf_assoclist_entry *e;
+	int found;
+};
+
+static int station_get_cb(const struct lwf_assoclist_entry *e, void *ctx)
+{
+	struct station_get_ctx *g = ctx;
+
+	if (memcmp(e->mac, g->mac, sizeof(e->mac)))
+		return 0;
+
+	*g->e = *e;
+	g->found = 1;
+
+	return 1;
+}
+
+int lwf_station_get(const char *ifname, const uint8_t *mac,
+                    struct lwf_assoclist_entry *e)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+	struct station_get_ctx g = { .mac = mac, .e = e };
+	int rv;
+
+	if (!iw)
+		return -ENODEV;
+
+	if (iw->station_get)
+		return iw->station_get(ifname, mac, e);
+
+	/* backends without a direct query are searched linearly */
+	if ((rv = station_foreach(iw, ifname, station_get_cb, &g)) != 0)
+		return rv;
+
+	return g.found ? 0 : -ENOENT;
+}
+
+int lwf_scanlist_cached(const char *ifname, int max_age, struct lwf_buf *b)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	if (!iw->scanlist_cached)
+		return -EOPNOTSUPP;
+
+	return iw->scanlist_cached(ifname, max_age, b);
+}
+
+int lwf_scanlist_params(const char *ifname, const struct lwf_scan_params *p,
+                        struct lwf_buf *b)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	if (!iw->scanlist_params)
+		return -EOPNOTSUPP;
+
+	return iw->scanlist_params(ifname, p, b);
+}
+
+int lwf_scanlist_v2(const char *ifname, const struct lwf_scan_params *p,
+                    uint32_t info, struct lwf_buf *b)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	if (!iw->scanlist_v2)
+		return -EOPNOTSUPP;
+
+	return iw->scanlist_v2(ifname, p, info, b);
+}
+
+int lwf_station_summary(const char *ifname, struct lwf_station_summary *s)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	if (!iw->station_summary)
+		return -EOPNOTSUPP;
+
+	return iw->station_summary(ifname, s);
+}
+
+int lwf_station_watch(const char *ifname,
+	void (*cb)(const struct lwf_station_notify *n, void *ctx), void *ctx)
+{
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw)
+		return -ENODEV;
+
+	if (!iw->station_watch)
+		return -EOPNOTSUPP;
+
+	return iw->station_watch(ifname, cb, ctx);
+}
+
+int lwf_station_unwatch(const char *ifname)
+{
+	int i, rv = -ENOENT;
+
+	/* the interface may be gone already, ask every backend */
+	for (i = 0; i < ARRAY_SIZE(backends); i++)
+		if (backends[i]->station_unwatch &&
+		    !backends[i]->station_unwatch(ifname))
+			rv = 0;
+
+	return rv;
+}
+
+int lwf_dispatch(void)
+{
+	int i, rv = 0;
+
+	for (i = 0; i < ARRAY_SIZE(backends); i++)
+		if (backends[i]->dispatch && backends[i]->dispatch() < 0)
+			rv = -1;
+
+	return rv;
+}
+
+int lwf_async_fd(const struct lwf_ops *iw)
+{
+	if (!iw->async_fd)
+		return -EOPNOTSUPP;
+
+	return iw->async_fd();
+}
+
+int lwf_async_list(const struct lwf_ops *iw, const char *ifname,
+	enum lwf_list_type type, struct lwf_buf *b,
+	void (*done)(int err, struct lwf_buf *b, void *ctx), void *ctx)
+{
+	if (!iw->async_list)
+		return -EOPNOTSUPP;
+
+	return iw->async_list(ifname, type, b, done, ctx);
+}
+
+int lwf_async_process(const struct lwf_ops *iw)
+{
+	if (!iw->async_process)
+		return -EOPNOTSUPP;
+
+	return iw->async_process();
+}
+
+
+/*
+ * asynchronous scans
+ */
+struct lwf_scan {
+	const struct lwf_ops *iw;
+	void *priv;
+};
+
+struct lwf_scan * lwf_scan_start(const char *ifname,
+	const struct lwf_scan_params *p, int timeout,
+	void (*cb)(const struct lwf_scanlist_entry *e, void *ctx), void *ctx)
+{
+	struct lwf_scan *s;
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw || !iw->scan_start || !(s = calloc(1, sizeof(*s))))
+		return NULL;
+
+	s->iw = iw;
+
+	if (!(s->priv = iw->scan_start(ifname, p, timeout, cb, ctx)))
+	{
+		free(s);
+		return NULL;
+	}
+
+	return s;
+}
+
+int lwf_scan_fd(struct lwf_scan *s)
+{
+	return s->iw->scan_fd();
+}
+
+int lwf_scan_poll(struct lwf_scan *s)
+{
+	return s->iw->scan_poll(s->priv);
+}
+
+void lwf_scan_free(struct lwf_scan *s)
+{
+	if (!s)
+		return;
+
+	s->iw->scan_free(s->priv);
+	free(s);
+}
+
+
+/*
+ * station tracker
+ */
+#define STATION_HASH_SIZE	256
+
+struct station_node {
+	struct station_node *next;
+	struct lwf_assoclist_entry e;
+	double ts;
+	unsigned int gen;
+};
+
+struct lwf_station_tracker {
+	const struct lwf_ops *iw;
+	char ifname[IFNAMSIZ];
+	unsigned int gen;
+	double now;
+	void (*cb)(const struct lwf_station_delta *d, void *ctx);
+	void *ctx;
+	struct station_node *hash[STATION_HASH_SIZE];
+};
+
+static double station_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static unsigned int station_hash(const uint8_t *mac)
+{
+	return (mac[3] ^ (mac[4] * 31) ^ (mac[5] * 131)) % STATION_HASH_SIZE;
+}
+
+static int station_changed(const struct lwf_assoclist_entry *a,
+                           const struct lwf_assoclist_entry *b)
+{
+	return (a->rx_bytes   != b->rx_bytes   ||
+	        a->tx_bytes   != b->tx_bytes   ||
+	        a->rx_packets != b->rx_packets ||
+	        a->tx_packets != b->tx_packets ||
+	        a->tx_retries != b->tx_retries ||
+	        a->tx_failed  != b->tx_failed);
+}
+
+static int station_tracker_cb(const struct lwf_assoclist_entry *e, void *ctx)
+{
+	int bits, notify = 1;
+	struct lwf_station_tracker *t = ctx;
+	struct lwf_station_delta d = { .entry = e };
+	struct station_node *n, **head = &t->hash[station_hash(e->mac)];
+
+	for (n = *head; n; n = n->next)
+		if (!memcmp(n->e.mac, e->mac, sizeof(e->mac)))
+			break;
+
+	if (!n)
+	{
+		if (!(n = calloc(1, sizeof(*n))))
+			return 0;
+
+		n->next = *head;
+		*head = n;
+
+		d.event = LWF_STATION_ADDED;
+	}
+	else if (station_changed(&n->e, e))
+	{
+		d.event = LWF_STATION_CHANGED;
+		d.interval = t->now - n->ts;
+
+		/* the deltas are masked to the counter width, which copes with a
+		 * single wrap between two samples */
+		bits = e->is_bytes64 ? 64 : 32;
+
+		if (d.interval > 0)
+		{
+			d.rx_bytes   = lwf_counter_delta(n->e.rx_bytes, e->rx_bytes, bits) / d.interval;
+			d.tx_bytes   = lwf_counter_delta(n->e.tx_bytes, e->tx_bytes, bits) / d.interval;
+			d.rx_packets = lwf_counter_delta(n->e.rx_packets, e->rx_packets, 32) / d.interval;
+			d.tx_packets = lwf_counter_delta(n->e.tx_packets, e->tx_packets, 32) / d.interval;
+			d.tx_retries = lwf_counter_delta(n->e.tx_retries, e->tx_retries, 32) / d.interval;
+			d.tx_failed  = lwf_counter_delta(n->e.tx_failed, e->tx_failed, 32) / d.interval;
+		}
+	}
+	else
+	{
+		notify = 0;
+	}
+
+	/* the latest sample is always kept, so that the next delta covers
+	 * exactly one poll interval */
+	n->e = *e;
+	n->ts = t->now;
+	n->gen = t->gen;
+
+	if (notify)
+		t->cb(&d, t->ctx);
+
+	return 0;
+}
+
+struct lwf_station_tracker * lwf_station_tracker_new(const char *ifname)
+{
+	struct lwf_station_tracker *t;
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw || !(t = calloc(1, sizeof(*t))))
+		return NULL;
+
+	t->iw = iw;
+	strncpy(t->ifname, ifname, sizeof(t->ifname) - 1);
+
+	return t;
+}
+
+void lwf_station_tracker_free(struct lwf_station_tracker *t)
+{
+	int i;
+	struct station_node *n, *next;
+
+	if (!t)
+		return;
+
+	for (i = 0; i < STATION_HASH_SIZE; i++)
+		for (n = t->hash[i]; n; n = next)
+		{
+			next = n->next;
+			free(n);
+		}
+
+	free(t);
+}
+
+int lwf_station_tracker_poll(struct lwf_station_tracker *t,
+	void (*cb)(const struct lwf_station_delta *d, void *ctx), void *ctx)
+{
+	int i, rv;
+	struct station_node *n, **prev;
+	struct lwf_station_delta d = { .event = LWF_STATION_REMOVED };
+
+	t->gen++;
+	t->now = station_now();
+	t->cb = cb;
+	t->ctx = ctx;
+
+	if ((rv = station_foreach(t->iw, t->ifname, station_tracker_cb, t)) != 0)
+		return rv;
+
+	/* whatever was not seen in this dump has gone away */
+	for (i = 0; i < STATION_HASH_SIZE; i++)
+	{
+		for (prev = &t->hash[i]; (n = *prev) != NULL; )
+		{
+			if (n->gen == t->gen)
+			{
+				prev = &n->next;
+				continue;
+			}
+
+			*prev = n->next;
+
+			d.entry = &n->e;
+			d.interval = t->now - n->ts;
+			cb(&d, ctx);
+
+			free(n);
+		}
+	}
+
+	return 0;
+}
+
 void lwf_finish(void)
 {
 	int i;
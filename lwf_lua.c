@@ -46,7 +46,7 @@ static int lwf_L__gc(lua_State *L)
 
 static char * lwf_crypto_print_ciphers(int ciphers)
 {
-	static char str[128] = { 0 };
+	static __thread char str[128] = { 0 };
 	char *pos = str;
 
 	if (ciphers & LWF_CIPHER_WEP40)
@@ -80,7 +80,7 @@ static char * lwf_crypto_print_ciphers(int ciphers)
 
 static char * lwf_crypto_print_suites(int suites)
 {
-	static char str[64] = { 0 };
+	static __thread char str[64] = { 0 };
 	char *pos = str;
 
 	if (suites & LWF_KMGMT_PSK)
@@ -99,7 +99,7 @@ static char * lwf_crypto_print_suites(int suites)
 
 static char * lwf_crypto_desc(struct lwf_crypto_entry *c)
 {
-	static char desc[512] = { 0 };
+	static __thread char desc[512] = { 0 };
 
 	if (c)
 	{
@@ -248,7 +248,134 @@ static int lwf_L_mode(lua_State *L, int (*func)(const char *, int *))
 	return 1;
 }
 
-static void set_rateinfo(lua_State *L, struct lwf_rate_entry *r, bool rx)
+static void lwf_L_pushsnapshot(lua_State *L, const struct lwf_iface_snapshot *s)
+{
+	lua_newtable(L);
+
+	lua_pushstring(L, LWF_OPMODE_NAMES[s->mode]);
+	lua_setfield(L, -2, "mode");
+
+	if (s->ssid[0])
+	{
+		lua_pushstring(L, s->ssid);
+		lua_setfield(L, -2, "ssid");
+	}
+
+	if (s->bssid[0])
+	{
+		lua_pushstring(L, s->bssid);
+		lua_setfield(L, -2, "bssid");
+	}
+
+	if (s->channel > 0)
+	{
+		lua_pushnumber(L, s->channel);
+		lua_setfield(L, -2, "channel");
+	}
+
+	if (s->frequency > 0)
+	{
+		lua_pushnumber(L, s->frequency);
+		lua_setfield(L, -2, "frequency");
+	}
+
+	if (s->txpower >= 0)
+	{
+		lua_pushnumber(L, s->txpower);
+		lua_setfield(L, -2, "txpower");
+	}
+
+	if (s->bitrate > 0)
+	{
+		lua_pushnumber(L, s->bitrate);
+		lua_setfield(L, -2, "bitrate");
+	}
+
+	if (s->signal)
+	{
+		lua_pushnumber(L, s->signal);
+		lua_setfield(L, -2, "signal");
+	}
+
+	if (s->noise)
+	{
+		lua_pushnumber(L, s->noise);
+		lua_setfield(L, -2, "noise");
+	}
+
+	if (s->quality >= 0)
+	{
+		lua_pushnumber(L, s->quality);
+		lua_setfield(L, -2, "quality");
+	}
+
+	if (s->quality_max >= 0)
+	{
+		lua_pushnumber(L, s->quality_max);
+		lua_setfield(L, -2, "quality_max");
+	}
+
+}
+
+/* Wrapper for snapshot, a table of interface names is queried in one batch */
+static int lwf_L_snapshot(lua_State *L, const struct lwf_ops *ops)
+{
+	struct lwf_iface_snapshot s, *sv;
+	const char **ifnames;
+	int i, n;
+
+	if (!lua_istable(L, 1))
+	{
+		if (ops->snapshot(luaL_checkstring(L, 1), &s))
+			return 0;
+
+		lwf_L_pushsnapshot(L, &s);
+		return 1;
+	}
+
+	n = lua_objlen(L, 1);
+
+	/* the names stay referenced by the table, so only accept real strings
+	 * which are neither converted nor collected while in use */
+	for (i = 0; i < n; i++)
+	{
+		lua_rawgeti(L, 1, i + 1);
+
+		if (lua_type(L, -1) != LUA_TSTRING)
+			luaL_argerror(L, 1, "table of interface names expected");
+
+		lua_pop(L, 1);
+	}
+
+	/* userdata is reclaimed by the collector should a Lua error unwind */
+	ifnames = lua_newuserdata(L, (n + 1) * sizeof(*ifnames));
+	sv = lua_newuserdata(L, (n + 1) * sizeof(*sv));
+
+	memset(ifnames, 0, (n + 1) * sizeof(*ifnames));
+	memset(sv, 0, (n + 1) * sizeof(*sv));
+
+	for (i = 0; i < n; i++)
+	{
+		lua_rawgeti(L, 1, i + 1);
+		ifnames[i] = lua_tostring(L, -1);
+		lua_pop(L, 1);
+	}
+
+	if (ops->snapshots(ifnames, n, sv))
+		return 0;
+
+	lua_newtable(L);
+
+	for (i = 0; i < n; i++)
+	{
+		lwf_L_pushsnapshot(L, &sv[i]);
+		lua_setfield(L, -2, ifnames[i]);
+	}
+
+	return 1;
+}
+
+static void set_rateinfo(lua_State *L, const struct lwf_rate_entry *r, bool rx)
 {
 	lua_pushnumber(L, r->rate);
 	lua_setfield(L, -2, rx ? "rx_rate" : "tx_rate");
@@ -286,77 +413,482 @@ static void set_rateinfo(lua_State *L, struct lwf_rate_entry *r, bool rx)
 	}
 }
 
+/* Push a station table for e and return its MAC as string */
+static const char * lwf_L_stationtable(lua_State *L,
+                                       const struct lwf_assoclist_entry *e)
+{
+	static __thread char macstr[18];
+
+	sprintf(macstr, "%02X:%02X:%02X:%02X:%02X:%02X",
+		e->mac[0], e->mac[1], e->mac[2],
+		e->mac[3], e->mac[4], e->mac[5]);
+
+	lua_newtable(L);
+
+	lua_pushnumber(L, e->signal);
+	lua_setfield(L, -2, "signal");
+
+	lua_pushnumber(L, e->noise);
+	lua_setfield(L, -2, "noise");
+
+	lua_pushnumber(L, e->inactive);
+	lua_setfield(L, -2, "inactive");
+
+	lua_pushnumber(L, e->rx_packets);
+	lua_setfield(L, -2, "rx_packets");
+
+	lua_pushnumber(L, e->tx_packets);
+	lua_setfield(L, -2, "tx_packets");
+
+	lua_pushnumber(L, e->rx_bytes);
+	lua_setfield(L, -2, "rx_bytes");
+
+	lua_pushnumber(L, e->tx_bytes);
+	lua_setfield(L, -2, "tx_bytes");
+
+	lua_pushboolean(L, e->is_bytes64);
+	lua_setfield(L, -2, "bytes64");
+
+	if (e->rx_duration) {
+		lua_pushnumber(L, e->rx_duration);
+		lua_setfield(L, -2, "rx_duration");
+	}
+
+	if (e->tx_duration) {
+		lua_pushnumber(L, e->tx_duration);
+		lua_setfield(L, -2, "tx_duration");
+	}
+
+	if (e->beacon_rx) {
+		lua_pushnumber(L, e->beacon_rx);
+		lua_setfield(L, -2, "beacon_rx");
+	}
+
+	set_rateinfo(L, &e->rx_rate, true);
+	set_rateinfo(L, &e->tx_rate, false);
+
+	if (e->thr) {
+		lua_pushnumber(L, e->thr);
+		lua_setfield(L, -2, "expected_throughput");
+	}
+
+	return macstr;
+}
+
 /* Wrapper for assoclist */
-static int lwf_L_assoclist(lua_State *L, int (*func)(const char *, char *, int *))
+struct lwf_L_assoclist_ctx {
+	lua_State *L;
+	int table;
+	int err;
+};
+
+static int lwf_L_assoclist_add(lua_State *L)
 {
-	int i, len;
-	char rv[LWF_BUFSIZE];
-	char macstr[18];
+	const char *macstr = lwf_L_stationtable(L, lua_touserdata(L, 2));
+
+	lua_setfield(L, 1, macstr);
+
+	return 0;
+}
+
+/*
+ * Entries may arrive in the middle of a netlink dump, which a Lua error must
+ * not unwind. The table is filled in protected mode and an error is raised
+ * once the iteration returned.
+ */
+static int lwf_L_assoclist_cb(const struct lwf_assoclist_entry *e, void *ctx)
+{
+	struct lwf_L_assoclist_ctx *c = ctx;
+
+	lua_pushvalue(c->L, c->table + 1);
+	lua_pushvalue(c->L, c->table);
+	lua_pushlightuserdata(c->L, (void *)e);
+
+	if (lua_pcall(c->L, 2, 0, 0))
+	{
+		c->err = 1;
+		return 1;
+	}
+
+	return 0;
+}
+
+static int lwf_L_assoclist(lua_State *L, const struct lwf_ops *iw)
+{
+	int i;
+	struct lwf_buf b = { .grow = 1 };
+	struct lwf_L_assoclist_ctx c = { .L = L };
 	const char *ifname = luaL_checkstring(L, 1);
-	struct lwf_assoclist_entry *e;
 
 	lua_newtable(L);
-	memset(rv, 0, sizeof(rv));
+	c.table = lua_gettop(L);
+
+	lua_pushcfunction(L, lwf_L_assoclist_add);
 
-	if (!(*func)(ifname, rv, &len))
+	/* stream the entries straight into the table when possible */
+	if (iw->station_foreach)
 	{
-		for (i = 0; i < len; i += sizeof(struct lwf_assoclist_entry))
-		{
-			e = (struct lwf_assoclist_entry *) &rv[i];
+		iw->station_foreach(ifname, lwf_L_assoclist_cb, &c);
+	}
+	else if (!lwf_list(iw, ifname, LWF_LIST_ASSOC, &b))
+	{
+		for (i = 0; i < b.len && !c.err; i += sizeof(struct lwf_assoclist_entry))
+			lwf_L_assoclist_cb((struct lwf_assoclist_entry *)&b.buf[i], &c);
+	}
 
-			sprintf(macstr, "%02X:%02X:%02X:%02X:%02X:%02X",
-				e->mac[0], e->mac[1], e->mac[2],
-				e->mac[3], e->mac[4], e->mac[5]);
+	lwf_buf_free(&b);
 
-			lua_newtable(L);
+	/* the error message is left on top of the stack by lua_pcall() */
+	if (c.err)
+		return lua_error(L);
 
-			lua_pushnumber(L, e->signal);
-			lua_setfield(L, -2, "signal");
+	lua_settop(L, c.table);
+	return 1;
+}
 
-			lua_pushnumber(L, e->noise);
-			lua_setfield(L, -2, "noise");
+/* Wrapper for station_get, returns nil if the station is not associated */
+static int lwf_L_station(lua_State *L, const struct lwf_ops *iw)
+{
+	const char *ifname = luaL_checkstring(L, 1);
+	const char *macstr = luaL_checkstring(L, 2);
+	struct lwf_assoclist_entry e;
+	unsigned int mac[6];
+	uint8_t addr[6];
+	int i;
 
-			lua_pushnumber(L, e->inactive);
-			lua_setfield(L, -2, "inactive");
+	if (!iw->station_get ||
+	    sscanf(macstr, "%02x:%02x:%02x:%02x:%02x:%02x",
+	           &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5]) != 6)
+		return 0;
 
-			lua_pushnumber(L, e->rx_packets);
-			lua_setfield(L, -2, "rx_packets");
+	for (i = 0; i < 6; i++)
+		addr[i] = mac[i];
 
-			lua_pushnumber(L, e->tx_packets);
-			lua_setfield(L, -2, "tx_packets");
+	if (iw->station_get(ifname, addr, &e))
+		return 0;
 
-			set_rateinfo(L, &e->rx_rate, true);
-			set_rateinfo(L, &e->tx_rate, false);
+	lwf_L_stationtable(L, &e);
+	return 1;
+}
 
-			if (e->thr) {
-				lua_pushnumber(L, e->thr);
-				lua_setfield(L, -2, "expected_throughput");
-			}
+/* Wrapper for station_summary */
+static int lwf_L_station_summary(lua_State *L, const struct lwf_ops *iw)
+{
+	const char *ifname = luaL_checkstring(L, 1);
+	struct lwf_station_summary s;
+
+	if (!iw->station_summary || iw->station_summary(ifname, &s))
+		return 0;
+
+	lua_newtable(L);
+
+	lua_pushnumber(L, s.count);
+	lua_setfield(L, -2, "count");
+
+	if (s.signal_count)
+	{
+		lua_pushnumber(L, s.signal_mean);
+		lua_setfield(L, -2, "signal_mean");
+
+		lua_pushnumber(L, s.signal_min);
+		lua_setfield(L, -2, "signal_min");
+
+		lua_pushnumber(L, s.signal_max);
+		lua_setfield(L, -2, "signal_max");
+
+		lua_pushnumber(L, s.signal_median);
+		lua_setfield(L, -2, "signal_median");
+	}
+
+	lua_pushnumber(L, s.tx_rate_mean);
+	lua_setfield(L, -2, "tx_rate_mean");
+
+	lua_pushnumber(L, s.rx_rate_mean);
+	lua_setfield(L, -2, "rx_rate_mean");
+
+	return 1;
+}
 
-			lua_setfield(L, -2, macstr);
+/* Station events, queued until lwf.nl80211.events() is called */
+struct lwf_L_event {
+	struct lwf_station_notify n;
+	struct lwf_assoclist_entry e;
+};
+
+static __thread struct lwf_buf lwf_L_event_queue = { .grow = 1 };
+
+static void lwf_L_watch_cb(const struct lwf_station_notify *n, void *ctx)
+{
+	struct lwf_L_event *ev = lwf_buf_add(&lwf_L_event_queue, sizeof(*ev));
+
+	if (!ev)
+		return;
+
+	ev->n = *n;
+
+	if (n->entry)
+		ev->e = *n->entry;
+}
+
+static int lwf_L_watch(lua_State *L)
+{
+	const char *ifname = luaL_checkstring(L, 1);
+	int fd = lwf_station_watch(ifname, lwf_L_watch_cb, NULL);
+
+	if (fd < 0)
+		lua_pushnil(L);
+	else
+		lua_pushinteger(L, fd);
+
+	return 1;
+}
+
+static int lwf_L_unwatch(lua_State *L)
+{
+	const char *ifname = luaL_checkstring(L, 1);
+
+	lua_pushboolean(L, !lwf_station_unwatch(ifname));
+	return 1;
+}
+
+static int lwf_L_events(lua_State *L)
+{
+	int i, x;
+	char macstr[18];
+	struct lwf_L_event *ev;
+	static const char *types[] = {
+		[LWF_STATION_NOTIFY_NEW]         = "new",
+		[LWF_STATION_NOTIFY_DEL]         = "del",
+		[LWF_STATION_NOTIFY_CONN_FAILED] = "conn_failed",
+		[LWF_STATION_NOTIFY_DISCONNECT]  = "disconnect",
+	};
+
+	lwf_dispatch();
+
+	lua_newtable(L);
+
+	for (i = 0, x = 1; i < lwf_L_event_queue.len; i += sizeof(*ev), x++)
+	{
+		ev = (struct lwf_L_event *)&lwf_L_event_queue.buf[i];
+
+		if (ev->n.entry)
+			lwf_L_stationtable(L, &ev->e);
+		else
+			lua_newtable(L);
+
+		sprintf(macstr, "%02X:%02X:%02X:%02X:%02X:%02X",
+			ev->n.mac[0], ev->n.mac[1], ev->n.mac[2],
+			ev->n.mac[3], ev->n.mac[4], ev->n.mac[5]);
+
+		lua_pushstring(L, types[ev->n.type]);
+		lua_setfield(L, -2, "event");
+
+		lua_pushstring(L, ev->n.ifname);
+		lua_setfield(L, -2, "ifname");
+
+		lua_pushstring(L, macstr);
+		lua_setfield(L, -2, "mac");
+
+		if (ev->n.reason)
+		{
+			lua_pushnumber(L, ev->n.reason);
+			lua_setfield(L, -2, "reason");
 		}
+
+		lua_rawseti(L, -2, x);
+	}
+
+	lwf_buf_free(&lwf_L_event_queue);
+
+	return 1;
+}
+
+static int lwf_L_stations(lua_State *L)
+{
+	int i;
+	const char *macstr;
+	struct lwf_buf b = { .grow = 1 };
+	const char *ifname = luaL_checkstring(L, 1);
+	const struct lwf_ops *iw = lwf_backend(ifname);
+
+	if (!iw || lwf_list(iw, ifname, LWF_LIST_ASSOC_WATCHED, &b))
+	{
+		lwf_buf_free(&b);
+		return 0;
+	}
+
+	lua_newtable(L);
+
+	for (i = 0; i < b.len; i += sizeof(struct lwf_assoclist_entry))
+	{
+		macstr = lwf_L_stationtable(L, (struct lwf_assoclist_entry *)&b.buf[i]);
+		lua_setfield(L, -2, macstr);
+	}
+
+	lwf_buf_free(&b);
+	return 1;
+}
+
+/* lwf.timeout(ms) sets the request timeout of the current context */
+static int lwf_L_timeout(lua_State *L)
+{
+	lwf_set_timeout(luaL_checkinteger(L, 1));
+	return 0;
+}
+
+/* Wrap-aware counter accumulator, lwf.counter([bits]) */
+static int lwf_L_counter(lua_State *L)
+{
+	struct lwf_counter *c = lua_newuserdata(L, sizeof(*c));
+
+	memset(c, 0, sizeof(*c));
+	c->bits = luaL_optinteger(L, 1, 32);
+
+	luaL_getmetatable(L, LWF_COUNTER_META);
+	lua_setmetatable(L, -2);
+
+	return 1;
+}
+
+static int lwf_L_counter_update(lua_State *L)
+{
+	struct lwf_counter *c = luaL_checkudata(L, 1, LWF_COUNTER_META);
+
+	lua_pushnumber(L, lwf_counter_update(c, (uint64_t)luaL_checknumber(L, 2)));
+	return 1;
+}
+
+static int lwf_L_counter_total(lua_State *L)
+{
+	struct lwf_counter *c = luaL_checkudata(L, 1, LWF_COUNTER_META);
+
+	lua_pushnumber(L, c->total);
+	return 1;
+}
+
+/* Station tracker */
+static int lwf_L_tracker(lua_State *L)
+{
+	const char *ifname = luaL_checkstring(L, 1);
+	struct lwf_station_tracker **t;
+
+	t = lua_newuserdata(L, sizeof(*t));
+
+	if (!(*t = lwf_station_tracker_new(ifname)))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	luaL_getmetatable(L, LWF_TRACKER_META);
+	lua_setmetatable(L, -2);
+
+	return 1;
+}
+
+static int lwf_L_tracker__gc(lua_State *L)
+{
+	struct lwf_station_tracker **t = luaL_checkudata(L, 1, LWF_TRACKER_META);
+
+	lwf_station_tracker_free(*t);
+	*t = NULL;
+
+	return 0;
+}
+
+static void lwf_L_tracker_cb(const struct lwf_station_delta *d, void *ctx)
+{
+	lua_State *L = ctx;
+	const char *macstr;
+
+	/* result table layout: { added = { }, changed = { }, removed = { } } */
+	switch (d->event)
+	{
+	case LWF_STATION_ADDED:
+		lua_getfield(L, -1, "added");
+		break;
+
+	case LWF_STATION_CHANGED:
+		lua_getfield(L, -1, "changed");
+		break;
+
+	case LWF_STATION_REMOVED:
+		lua_getfield(L, -1, "removed");
+		break;
+	}
+
+	macstr = lwf_L_stationtable(L, d->entry);
+
+	if (d->event == LWF_STATION_CHANGED)
+	{
+		lua_pushnumber(L, d->interval);
+		lua_setfield(L, -2, "interval");
+
+		lua_pushnumber(L, d->rx_bytes);
+		lua_setfield(L, -2, "rx_bytes_rate");
+
+		lua_pushnumber(L, d->tx_bytes);
+		lua_setfield(L, -2, "tx_bytes_rate");
+
+		lua_pushnumber(L, d->rx_packets);
+		lua_setfield(L, -2, "rx_packets_rate");
+
+		lua_pushnumber(L, d->tx_packets);
+		lua_setfield(L, -2, "tx_packets_rate");
+
+		lua_pushnumber(L, d->tx_retries);
+		lua_setfield(L, -2, "tx_retries_rate");
+
+		lua_pushnumber(L, d->tx_failed);
+		lua_setfield(L, -2, "tx_failed_rate");
+	}
+
+	lua_setfield(L, -2, macstr);
+	lua_pop(L, 1);
+}
+
+static int lwf_L_tracker_poll(lua_State *L)
+{
+	struct lwf_station_tracker **t = luaL_checkudata(L, 1, LWF_TRACKER_META);
+
+	if (!*t)
+		return 0;
+
+	lua_newtable(L);
+
+	lua_newtable(L);
+	lua_setfield(L, -2, "added");
+
+	lua_newtable(L);
+	lua_setfield(L, -2, "changed");
+
+	lua_newtable(L);
+	lua_setfield(L, -2, "removed");
+
+	if (lwf_station_tracker_poll(*t, lwf_L_tracker_cb, L))
+	{
+		lua_pop(L, 1);
+		lua_pushnil(L);
 	}
 
 	return 1;
 }
 
 /* Wrapper for tx power list */
-static int lwf_L_txpwrlist(lua_State *L, int (*func)(const char *, char *, int *))
+static int lwf_L_txpwrlist(lua_State *L, const struct lwf_ops *iw)
 {
-	int i, x, len;
-	char rv[LWF_BUFSIZE];
+	int i, x;
+	struct lwf_buf b = { .grow = 1 };
 	const char *ifname = luaL_checkstring(L, 1);
 	struct lwf_txpwrlist_entry *e;
 
-	memset(rv, 0, sizeof(rv));
-
-	if (!(*func)(ifname, rv, &len))
+	if (!lwf_list(iw, ifname, LWF_LIST_TXPWR, &b))
 	{
 		lua_newtable(L);
 
-		for (i = 0, x = 1; i < len; i += sizeof(struct lwf_txpwrlist_entry), x++)
+		for (i = 0, x = 1; i < b.len; i += sizeof(struct lwf_txpwrlist_entry), x++)
 		{
-			e = (struct lwf_txpwrlist_entry *) &rv[i];
+			e = (struct lwf_txpwrlist_entry *) &b.buf[i];
 
 			lua_newtable(L);
 
@@ -369,92 +901,276 @@ static int lwf_L_txpwrlist(lua_State *L, int (*func)(const char *, char *, int *
 			lua_rawseti(L, -2, x);
 		}
 
+		lwf_buf_free(&b);
 		return 1;
 	}
 
+	lwf_buf_free(&b);
 	return 0;
 }
 
-/* Wrapper for scan list */
-static int lwf_L_scanlist(lua_State *L, int (*func)(const char *, char *, int *))
+/* Push a table of scan list entries */
+static void lwf_L_scanentry(lua_State *L, struct lwf_scanlist_entry *e)
 {
-	int i, x, len = 0;
-	char rv[LWF_BUFSIZE];
 	char macstr[18];
-	const char *ifname = luaL_checkstring(L, 1);
-	struct lwf_scanlist_entry *e;
 
 	lua_newtable(L);
-	memset(rv, 0, sizeof(rv));
 
-	if (!(*func)(ifname, rv, &len))
+	/* BSSID */
+	sprintf(macstr, "%02X:%02X:%02X:%02X:%02X:%02X",
+		e->mac[0], e->mac[1], e->mac[2],
+		e->mac[3], e->mac[4], e->mac[5]);
+
+	lua_pushstring(L, macstr);
+	lua_setfield(L, -2, "bssid");
+
+	/* ESSID */
+	if (e->ssid[0])
+	{
+		lua_pushstring(L, (char *) e->ssid);
+		lua_setfield(L, -2, "ssid");
+	}
+
+	/* Channel */
+	lua_pushinteger(L, e->channel);
+	lua_setfield(L, -2, "channel");
+
+	/* Mode */
+	lua_pushstring(L, LWF_OPMODE_NAMES[e->mode]);
+	lua_setfield(L, -2, "mode");
+
+	/* Quality, Signal */
+	lua_pushinteger(L, e->quality);
+	lua_setfield(L, -2, "quality");
+
+	lua_pushinteger(L, e->quality_max);
+	lua_setfield(L, -2, "quality_max");
+
+	lua_pushnumber(L, (e->signal - 0x100));
+	lua_setfield(L, -2, "signal");
+
+	/* Crypto */
+	lwf_L_cryptotable(L, &e->crypto);
+	lua_setfield(L, -2, "encryption");
+}
+
+static void lwf_L_pushscanlist(lua_State *L, struct lwf_buf *b)
+{
+	int i, x;
+
+	lua_newtable(L);
+
+	for (i = 0, x = 1; i < b->len; i += sizeof(struct lwf_scanlist_entry), x++)
+	{
+		lwf_L_scanentry(L, (struct lwf_scanlist_entry *) &b->buf[i]);
+		lua_rawseti(L, -2, x);
+	}
+}
+
+/* Read scan parameters from a table like { freqs = { 2412, 2437 },
+ * ssids = { "x" }, duration = 20, flush = true, low_priority = true,
+ * ap = true } */
+static void lwf_L_scanparams(lua_State *L, int idx, struct lwf_scan_params *p)
+{
+	int i;
+	const char *ssid;
+
+	memset(p, 0, sizeof(*p));
+
+	lua_getfield(L, idx, "freqs");
+	if (lua_istable(L, -1))
 	{
-		for (i = 0, x = 1; i < len; i += sizeof(struct lwf_scanlist_entry), x++)
+		for (i = 1; p->n_freqs < LWF_SCAN_MAX_FREQS; i++)
 		{
-			e = (struct lwf_scanlist_entry *) &rv[i];
+			lua_rawgeti(L, -1, i);
 
-			lua_newtable(L);
+			if (!lua_isnumber(L, -1))
+			{
+				lua_pop(L, 1);
+				break;
+			}
 
-			/* BSSID */
-			sprintf(macstr, "%02X:%02X:%02X:%02X:%02X:%02X",
-				e->mac[0], e->mac[1], e->mac[2],
-				e->mac[3], e->mac[4], e->mac[5]);
+			p->freqs[p->n_freqs++] = lua_tointeger(L, -1);
+			lua_pop(L, 1);
+		}
+	}
+	lua_pop(L, 1);
 
-			lua_pushstring(L, macstr);
-			lua_setfield(L, -2, "bssid");
+	lua_getfield(L, idx, "ssids");
+	if (lua_istable(L, -1))
+	{
+		for (i = 1; p->n_ssids < LWF_SCAN_MAX_SSIDS; i++)
+		{
+			lua_rawgeti(L, -1, i);
 
-			/* ESSID */
-			if (e->ssid[0])
+			if (!(ssid = lua_tostring(L, -1)))
 			{
-				lua_pushstring(L, (char *) e->ssid);
-				lua_setfield(L, -2, "ssid");
+				lua_pop(L, 1);
+				break;
 			}
 
-			/* Channel */
-			lua_pushinteger(L, e->channel);
-			lua_setfield(L, -2, "channel");
+			strncpy(p->ssids[p->n_ssids++], ssid, LWF_ESSID_MAX_SIZE);
+			lua_pop(L, 1);
+		}
+	}
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "duration");
+	p->duration = lua_tointeger(L, -1);
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "low_priority");
+	if (lua_toboolean(L, -1))
+		p->flags |= LWF_SCAN_FLAG_LOW_PRIORITY;
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "flush");
+	if (lua_toboolean(L, -1))
+		p->flags |= LWF_SCAN_FLAG_FLUSH;
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "ap");
+	if (lua_toboolean(L, -1))
+		p->flags |= LWF_SCAN_FLAG_AP;
+	lua_pop(L, 1);
+}
 
-			/* Mode */
-			lua_pushstring(L, LWF_OPMODE_NAMES[e->mode]);
-			lua_setfield(L, -2, "mode");
+/* Wrapper for scan list, optionally restricted by a parameter table */
+static int lwf_L_scanlist(lua_State *L, const struct lwf_ops *iw)
+{
+	struct lwf_buf b = { .grow = 1 };
+	struct lwf_scan_params p;
+	const char *ifname = luaL_checkstring(L, 1);
+	int rv;
 
-			/* Quality, Signal */
-			lua_pushinteger(L, e->quality);
-			lua_setfield(L, -2, "quality");
+	if (lua_istable(L, 2))
+	{
+		lwf_L_scanparams(L, 2, &p);
+		rv = iw->scanlist_params ? iw->scanlist_params(ifname, &p, &b) : -1;
+	}
+	else
+	{
+		rv = lwf_list(iw, ifname, LWF_LIST_SCAN, &b);
+	}
 
-			lua_pushinteger(L, e->quality_max);
-			lua_setfield(L, -2, "quality_max");
+	if (rv)
+		b.len = 0;
 
-			lua_pushnumber(L, (e->signal - 0x100));
-			lua_setfield(L, -2, "signal");
+	lwf_L_pushscanlist(L, &b);
+	lwf_buf_free(&b);
+	return 1;
+}
 
-			/* Crypto */
-			lwf_L_cryptotable(L, &e->crypto);
-			lua_setfield(L, -2, "encryption");
+/* Wrapper for scan list with decoded elements, all groups by default */
+static int lwf_L_scanlist_v2(lua_State *L, const struct lwf_ops *iw)
+{
+	int i, x;
+	struct lwf_buf b = { .grow = 1 };
+	struct lwf_scan_params p;
+	struct lwf_scanlist_entry_v2 *e;
+	const char *ifname = luaL_checkstring(L, 1);
+	uint32_t info = luaL_optinteger(L, 3, LWF_SCAN_INFO_ALL);
 
-			lua_rawseti(L, -2, x);
+	if (lua_istable(L, 2))
+		lwf_L_scanparams(L, 2, &p);
+
+	if (!iw->scanlist_v2 ||
+	    iw->scanlist_v2(ifname, lua_istable(L, 2) ? &p : NULL, info, &b))
+		b.len = 0;
+
+	lua_newtable(L);
+
+	for (i = 0, x = 1; i < b.len; i += sizeof(*e), x++)
+	{
+		e = (struct lwf_scanlist_entry_v2 *) &b.buf[i];
+
+		lwf_L_scanentry(L, &e->e);
+
+		if (e->info & LWF_SCAN_INFO_CHANNEL)
+		{
+			lua_pushinteger(L, e->primary_channel);
+			lua_setfield(L, -2, "primary_channel");
+
+			lua_pushinteger(L, e->secondary_offset);
+			lua_setfield(L, -2, "secondary_offset");
+
+			lua_pushinteger(L, e->width);
+			lua_setfield(L, -2, "width");
+		}
+
+		if (e->info & LWF_SCAN_INFO_LOAD)
+		{
+			lua_pushinteger(L, e->sta_count);
+			lua_setfield(L, -2, "sta_count");
+
+			lua_pushinteger(L, e->utilization);
+			lua_setfield(L, -2, "utilization");
+		}
+
+		if ((e->info & LWF_SCAN_INFO_COUNTRY) && e->country[0])
+		{
+			lua_pushstring(L, e->country);
+			lua_setfield(L, -2, "country");
+		}
+
+		if (e->info & LWF_SCAN_INFO_RATES)
+		{
+			lua_pushinteger(L, e->max_rate);
+			lua_setfield(L, -2, "max_rate");
+
+			lua_pushinteger(L, e->max_nss);
+			lua_setfield(L, -2, "max_nss");
+		}
+
+		if (e->info & LWF_SCAN_INFO_CAPS)
+		{
+			lua_pushboolean(L, e->caps & LWF_BSS_CAP_RRM);
+			lua_setfield(L, -2, "rrm");
+
+			lua_pushboolean(L, e->caps & LWF_BSS_CAP_BTM);
+			lua_setfield(L, -2, "btm");
+
+			lua_pushboolean(L, e->caps & LWF_BSS_CAP_FT);
+			lua_setfield(L, -2, "ft");
 		}
+
+		lua_rawseti(L, -2, x);
 	}
 
+	lwf_buf_free(&b);
+	return 1;
+}
+
+/* Wrapper for cached scan list, max age in ms defaults to unlimited */
+static int lwf_L_scanlist_cached(lua_State *L, const struct lwf_ops *iw)
+{
+	struct lwf_buf b = { .grow = 1 };
+	const char *ifname = luaL_checkstring(L, 1);
+	int max_age = luaL_optinteger(L, 2, -1);
+
+	if (!iw->scanlist_cached || iw->scanlist_cached(ifname, max_age, &b))
+		b.len = 0;
+
+	lwf_L_pushscanlist(L, &b);
+	lwf_buf_free(&b);
 	return 1;
 }
 
 /* Wrapper for frequency list */
-static int lwf_L_freqlist(lua_State *L, int (*func)(const char *, char *, int *))
+static int lwf_L_freqlist(lua_State *L, const struct lwf_ops *iw)
 {
-	int i, x, len;
-	char rv[LWF_BUFSIZE];
+	int i, x;
+	struct lwf_buf b = { .grow = 1 };
 	const char *ifname = luaL_checkstring(L, 1);
 	struct lwf_freqlist_entry *e;
 
 	lua_newtable(L);
-	memset(rv, 0, sizeof(rv));
 
-	if (!(*func)(ifname, rv, &len))
+	if (!lwf_list(iw, ifname, LWF_LIST_FREQ, &b))
 	{
-		for (i = 0, x = 1; i < len; i += sizeof(struct lwf_freqlist_entry), x++)
+		for (i = 0, x = 1; i < b.len; i += sizeof(struct lwf_freqlist_entry), x++)
 		{
-			e = (struct lwf_freqlist_entry *) &rv[i];
+			e = (struct lwf_freqlist_entry *) &b.buf[i];
 
 			lua_newtable(L);
 
@@ -474,6 +1190,7 @@ static int lwf_L_freqlist(lua_State *L, int (*func)(const char *, char *, int *)
 		}
 	}
 
+	lwf_buf_free(&b);
 	return 1;
 }
 
@@ -611,22 +1328,22 @@ static char * lwf_L_country_lookup(char *buf, int len, int iso3166)
 	return NULL;
 }
 
-static int lwf_L_countrylist(lua_State *L, int (*func)(const char *, char *, int *))
+static int lwf_L_countrylist(lua_State *L, const struct lwf_ops *iw)
 {
-	int len, i;
-	char rv[LWF_BUFSIZE], alpha2[3];
+	int i;
+	char alpha2[3];
+	struct lwf_buf b = { .grow = 1 };
 	char *ccode;
 	const char *ifname = luaL_checkstring(L, 1);
 	const struct lwf_iso3166_label *l;
 
 	lua_newtable(L);
-	memset(rv, 0, sizeof(rv));
 
-	if (!(*func)(ifname, rv, &len))
+	if (!lwf_list(iw, ifname, LWF_LIST_COUNTRY, &b))
 	{
 		for (l = LWF_ISO3166_NAMES, i = 1; l->iso3166; l++)
 		{
-			if ((ccode = lwf_L_country_lookup(rv, len, l->iso3166)) != NULL)
+			if ((ccode = lwf_L_country_lookup(b.buf, b.len, l->iso3166)) != NULL)
 			{
 				sprintf(alpha2, "%c%c",
 					(l->iso3166 / 256), (l->iso3166 % 256));
@@ -647,6 +1364,7 @@ static int lwf_L_countrylist(lua_State *L, int (*func)(const char *, char *, int
 		}
 	}
 
+	lwf_buf_free(&b);
 	return 1;
 }
 
@@ -668,16 +1386,21 @@ LUA_WRAP_STRING_OP(nl80211,country)
 LUA_WRAP_STRING_OP(nl80211,hardware_name)
 LUA_WRAP_STRING_OP(nl80211,phyname)
 LUA_WRAP_STRUCT_OP(nl80211,mode)
-LUA_WRAP_STRUCT_OP(nl80211,assoclist)
-LUA_WRAP_STRUCT_OP(nl80211,txpwrlist)
-LUA_WRAP_STRUCT_OP(nl80211,scanlist)
-LUA_WRAP_STRUCT_OP(nl80211,freqlist)
-LUA_WRAP_STRUCT_OP(nl80211,countrylist)
+LUA_WRAP_LIST_OP(nl80211,assoclist)
+LUA_WRAP_LIST_OP(nl80211,txpwrlist)
+LUA_WRAP_LIST_OP(nl80211,scanlist)
+LUA_WRAP_LIST_OP(nl80211,scanlist_cached)
+LUA_WRAP_LIST_OP(nl80211,scanlist_v2)
+LUA_WRAP_LIST_OP(nl80211,freqlist)
+LUA_WRAP_LIST_OP(nl80211,countrylist)
 LUA_WRAP_STRUCT_OP(nl80211,hwmodelist)
 LUA_WRAP_STRUCT_OP(nl80211,htmodelist)
 LUA_WRAP_STRUCT_OP(nl80211,encryption)
 LUA_WRAP_STRUCT_OP(nl80211,mbssid_support)
 LUA_WRAP_STRUCT_OP(nl80211,hardware_id)
+LUA_WRAP_LIST_OP(nl80211,snapshot)
+LUA_WRAP_LIST_OP(nl80211,station)
+LUA_WRAP_LIST_OP(nl80211,station_summary)
 #endif
 
 
@@ -701,6 +1424,8 @@ static const luaL_reg R_nl80211[] = {
 	LUA_REG(nl80211,assoclist),
 	LUA_REG(nl80211,txpwrlist),
 	LUA_REG(nl80211,scanlist),
+	LUA_REG(nl80211,scanlist_cached),
+	LUA_REG(nl80211,scanlist_v2),
 	LUA_REG(nl80211,freqlist),
 	LUA_REG(nl80211,countrylist),
 	LUA_REG(nl80211,hwmodelist),
@@ -710,10 +1435,32 @@ static const luaL_reg R_nl80211[] = {
 	LUA_REG(nl80211,hardware_id),
 	LUA_REG(nl80211,hardware_name),
 	LUA_REG(nl80211,phyname),
+	{ "info", lwf_L_nl80211_snapshot },
+	{ "tracker", lwf_L_tracker },
+	{ "watch", lwf_L_watch },
+	{ "unwatch", lwf_L_unwatch },
+	{ "events", lwf_L_events },
+	{ "stations", lwf_L_stations },
+	{ "station", lwf_L_nl80211_station },
+	{ "station_summary", lwf_L_nl80211_station_summary },
 	{ NULL, NULL }
 };
 #endif
 
+/* Counter methods */
+static const luaL_reg R_counter[] = {
+	{ "update", lwf_L_counter_update },
+	{ "total",  lwf_L_counter_total  },
+	{ NULL, NULL }
+};
+
+/* Station tracker methods */
+static const luaL_reg R_tracker[] = {
+	{ "poll", lwf_L_tracker_poll },
+	{ "__gc", lwf_L_tracker__gc  },
+	{ NULL, NULL }
+};
+
 /* Common */
 static const luaL_reg R_common[] = {
 	{ "type", lwf_L_type },
@@ -722,7 +1469,23 @@ static const luaL_reg R_common[] = {
 };
 
 LUALIB_API int luaopen_lwf(lua_State *L) {
+	luaL_newmetatable(L, LWF_TRACKER_META);
+	luaL_register(L, NULL, R_tracker);
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	lua_pop(L, 1);
+
+	luaL_newmetatable(L, LWF_COUNTER_META);
+	luaL_register(L, NULL, R_counter);
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	lua_pop(L, 1);
+
 	luaL_register(L, LWF_META, R_common);
+	lua_pushcfunction(L, lwf_L_counter);
+	lua_setfield(L, -2, "counter");
+	lua_pushcfunction(L, lwf_L_timeout);
+	lua_setfield(L, -2, "timeout");
 
 
 #ifdef USE_NL80211
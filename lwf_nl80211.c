@@ -27,36 +27,176 @@
 #include <fnmatch.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <poll.h>
+#include <time.h>
+#include <math.h>
 
 #include "lwf_nl80211.h"
 
-#define min(x, y) ((x) < (y)) ? (x) : (y)
+#define min(x, y) (((x) < (y)) ? (x) : (y))
+#define max(x, y) (((x) > (y)) ? (x) : (y))
 
 #define BIT(x) (1ULL<<(x))
 
-static struct nl80211_state *nls = NULL;
+#ifndef SOL_NETLINK
+#define SOL_NETLINK 270
+#endif
+
+#ifndef NETLINK_CAP_ACK
+#define NETLINK_CAP_ACK 10
+#endif
+
+#ifndef NETLINK_EXT_ACK
+#define NETLINK_EXT_ACK 11
+#endif
+
+/* large enough to ride out a burst of scan results on several radios */
+#define NL80211_EVENT_RCVBUF	(512 * 1024)
+
+/* scans may legitimately take several seconds on dual band radios */
+#define NL80211_SCAN_TIMEOUT	30000
+
+/* results of a full scan completed this many ms ago are shared */
+#define NL80211_SCAN_REUSE		2000
+
+/* EBUSY may as well mean remain-on-channel, so a foreign scan is only
+ * awaited this long before the EBUSY is passed on */
+#define NL80211_SCAN_BUSY_WAIT	10000
+
+/* interval in ms at which the cancel hook is polled while waiting */
+#define NL80211_POLL_SLICE		100
+
+/* lifetime in ms of a cached station summary */
+#define NL80211_SUMMARY_TTL		1000
+
+/* backend state of the calling thread's current library context */
+#define nls (lwf_ctx_get()->nl80211)
+#define nl80211_hwcache (lwf_ctx_get()->nl80211_hw)
+
+static void nl80211_wiphy_free(struct nl80211_wiphy_info *info)
+{
+	if (info)
+	{
+		free(info->freqs);
+		free(info);
+	}
+}
+
+static void nl80211_wiphy_invalidate(int phyidx)
+{
+	struct nl80211_wiphy_info *info, **prev;
+
+	for (prev = &nls->wiphy; (info = *prev) != NULL; )
+	{
+		if (phyidx < 0 || info->phyidx == phyidx)
+		{
+			*prev = info->next;
+			nl80211_wiphy_free(info);
+			continue;
+		}
+
+		prev = &info->next;
+	}
+}
+
+static void nl80211_sta_watch_free(struct nl80211_sta_watch *w)
+{
+	struct nl80211_sta_node *n, *next;
+
+	for (n = w->stations; n; n = next)
+	{
+		next = n->next;
+		free(n);
+	}
+
+	free(w);
+}
+
+static void nl80211_async_abort(int err);
+static void nl80211_hwcache_free(void);
+static void nl80211_links_free(void);
+static void nl80211_pool_free(void);
+static void nl80211_summary_free(void);
+static void nl80211_scan_free(void *handle);
+static void nl80211_scan_done_free(void);
+static void nl80211_mlme_free(void);
 
 static void nl80211_close(void)
 {
+	struct nl80211_sta_watch *w, *next;
+
+	nl80211_hwcache_free();
+
 	if (nls)
 	{
-		if (nls->nlctrl)
-			genl_family_put(nls->nlctrl);
+		nl80211_async_abort(-ECANCELED);
+
+		while (nls->scans)
+			nl80211_scan_free(nls->scans);
+
+		nl80211_scan_done_free();
+
+		if (nls->nl_async_cb)
+			nl_cb_put(nls->nl_async_cb);
+
+		if (nls->nl_async)
+			nl_socket_free(nls->nl_async);
+
+		nl80211_wiphy_invalidate(-1);
+		nl80211_wiphy_free(nls->wiphy_tmp);
+
+		for (w = nls->sta_watch; w; w = next)
+		{
+			next = w->next;
+			nl80211_sta_watch_free(w);
+		}
+
+		nl80211_mlme_free();
+
+		if (nls->nl_event_cb)
+			nl_cb_put(nls->nl_event_cb);
+
+		if (nls->nl_event)
+			nl_socket_free(nls->nl_event);
+
+		if (nls->nl_wait_cb)
+			nl_cb_put(nls->nl_wait_cb);
+
+		if (nls->nl_wait)
+			nl_socket_free(nls->nl_wait);
+
+		if (nls->nl_route_cb)
+			nl_cb_put(nls->nl_route_cb);
 
-		if (nls->nl80211)
-			genl_family_put(nls->nl80211);
+		if (nls->nl_route)
+			nl_socket_free(nls->nl_route);
+
+		nl80211_links_free();
+		nl80211_pool_free();
+		nl80211_summary_free();
 
 		if (nls->nl_sock)
 			nl_socket_free(nls->nl_sock);
 
-		if (nls->nl_cache)
-			nl_cache_free(nls->nl_cache);
-
 		free(nls);
 		nls = NULL;
 	}
 }
 
+static int nl80211_resolve_family(void);
+
+/*
+ * Request sockets ask for acks without the echoed request and for extended
+ * error reporting, older kernels simply reject the options.
+ */
+static void nl80211_sock_acks(struct nl_sock *sock)
+{
+	int fd = nl_socket_get_fd(sock), one = 1;
+
+	setsockopt(fd, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+	setsockopt(fd, SOL_NETLINK, NETLINK_EXT_ACK, &one, sizeof(one));
+}
+
 static int nl80211_init(void)
 {
 	int err, fd;
@@ -83,27 +223,16 @@ static int nl80211_init(void)
 		}
 
 		fd = nl_socket_get_fd(nls->nl_sock);
-		if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0) {
+		if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+		    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0) {
 			err = -EINVAL;
 			goto err;
 		}
 
-		if (genl_ctrl_alloc_cache(nls->nl_sock, &nls->nl_cache)) {
-			err = -ENOMEM;
-			goto err;
-		}
-
-		nls->nl80211 = genl_ctrl_search_by_name(nls->nl_cache, "nl80211");
-		if (!nls->nl80211) {
-			err = -ENOENT;
-			goto err;
-		}
+		nl80211_sock_acks(nls->nl_sock);
 
-		nls->nlctrl = genl_ctrl_search_by_name(nls->nl_cache, "nlctrl");
-		if (!nls->nlctrl) {
-			err = -ENOENT;
+		if ((err = nl80211_resolve_family()) != 0)
 			goto err;
-		}
 	}
 
 	return 0;
@@ -180,38 +309,115 @@ static int nl80211_msg_response(struct nl_msg *msg, void *arg)
 	return NL_SKIP;
 }
 
+/*
+ * Request messages and the synchronous callback set are recycled per
+ * context instead of being allocated for every request. A pooled message
+ * is reset to an empty header before reuse, the pooled callback set has
+ * its error, finish and ack handlers registered once.
+ */
+static struct nl_msg * nl80211_msg_get(void)
+{
+	struct nl_msg *msg;
+	struct nlmsghdr *hdr;
+
+	if (!nls || !nls->msg_pool_count)
+		return nlmsg_alloc();
+
+	msg = nls->msg_pool[--nls->msg_pool_count];
+	hdr = nlmsg_hdr(msg);
+
+	memset(hdr, 0, NLMSG_HDRLEN);
+	hdr->nlmsg_len = NLMSG_HDRLEN;
+
+	return msg;
+}
+
+static void nl80211_msg_put(struct nl_msg *msg)
+{
+	if (nls && nls->msg_pool_count < NL80211_MSG_POOL)
+		nls->msg_pool[nls->msg_pool_count++] = msg;
+	else
+		nlmsg_free(msg);
+}
+
+static struct nl_cb * nl80211_cb_get(void)
+{
+	if (!nls || nls->cb_pool_busy)
+		return nl_cb_alloc(NL_CB_DEFAULT);
+
+	if (!nls->cb_pool)
+	{
+		if (!(nls->cb_pool = nl_cb_alloc(NL_CB_DEFAULT)))
+			return NULL;
+
+		nl_cb_err(nls->cb_pool, NL_CB_CUSTOM,
+		          nl80211_msg_error, &nls->cb_pool_err);
+		nl_cb_set(nls->cb_pool, NL_CB_FINISH, NL_CB_CUSTOM,
+		          nl80211_msg_finish, &nls->cb_pool_err);
+		nl_cb_set(nls->cb_pool, NL_CB_ACK, NL_CB_CUSTOM,
+		          nl80211_msg_ack, &nls->cb_pool_err);
+	}
+
+	nls->cb_pool_busy = true;
+	return nls->cb_pool;
+}
+
+static void nl80211_cb_release(struct nl_cb *cb)
+{
+	if (nls && cb == nls->cb_pool)
+		nls->cb_pool_busy = false;
+	else
+		nl_cb_put(cb);
+}
+
+static void nl80211_pool_free(void)
+{
+	while (nls->msg_pool_count > 0)
+		nlmsg_free(nls->msg_pool[--nls->msg_pool_count]);
+
+	if (nls->cb_pool)
+		nl_cb_put(nls->cb_pool);
+
+	nls->cb_pool = NULL;
+	nls->cb_pool_busy = false;
+}
+
 static void nl80211_free(struct nl80211_msg_conveyor *cv)
 {
 	if (cv)
 	{
 		if (cv->cb)
-			nl_cb_put(cv->cb);
+			nl80211_cb_release(cv->cb);
 
 		if (cv->msg)
-			nlmsg_free(cv->msg);
+			nl80211_msg_put(cv->msg);
 
 		cv->cb  = NULL;
 		cv->msg = NULL;
 	}
 }
 
-static struct nl80211_msg_conveyor * nl80211_new(struct genl_family *family,
-                                                 int cmd, int flags)
+static struct nl80211_msg_conveyor * nl80211_new(int family, int cmd, int flags)
 {
-	static struct nl80211_msg_conveyor cv;
+	static __thread struct nl80211_msg_conveyor cv;
 
 	struct nl_msg *req = NULL;
 	struct nl_cb *cb = NULL;
 
-	req = nlmsg_alloc();
+	/* still owned by a request in progress, whose reply callback must
+	 * have called back into the library */
+	if (cv.msg || cv.cb)
+		return NULL;
+
+	req = nl80211_msg_get();
 	if (!req)
 		goto err;
 
-	cb = nl_cb_alloc(NL_CB_DEFAULT);
+	cb = nl80211_cb_get();
 	if (!cb)
 		goto err;
 
-	genlmsg_put(req, 0, 0, genl_family_get_id(family), 0, flags, cmd, 0);
+	genlmsg_put(req, 0, 0, family, 0, flags, cmd, 0);
 
 	cv.msg = req;
 	cv.cb  = cb;
@@ -220,7 +426,7 @@ static struct nl80211_msg_conveyor * nl80211_new(struct genl_family *family,
 
 err:
 	if (req)
-		nlmsg_free(req);
+		nl80211_msg_put(req);
 
 	return NULL;
 }
@@ -230,9 +436,11 @@ static struct nl80211_msg_conveyor * nl80211_ctl(int cmd, int flags)
 	if (nl80211_init() < 0)
 		return NULL;
 
-	return nl80211_new(nls->nlctrl, cmd, flags);
+	return nl80211_new(GENL_ID_CTRL, cmd, flags);
 }
 
+static int nl80211_ifindex(const char *ifname);
+
 static struct nl80211_msg_conveyor * nl80211_msg(const char *ifname,
                                                  int cmd, int flags)
 {
@@ -248,15 +456,15 @@ static struct nl80211_msg_conveyor * nl80211_msg(const char *ifname,
 	if (!strncmp(ifname, "phy", 3))
 		phyidx = atoi(&ifname[3]);
 	else if (!strncmp(ifname, "mon.", 4))
-		ifidx = if_nametoindex(&ifname[4]);
+		ifidx = nl80211_ifindex(&ifname[4]);
 	else
-		ifidx = if_nametoindex(ifname);
+		ifidx = nl80211_ifindex(ifname);
 
 	/* Valid ifidx must be greater than 0 */
 	if ((ifidx <= 0) && (phyidx < 0))
 		return NULL;
 
-	cv = nl80211_new(nls->nl80211, cmd, flags);
+	cv = nl80211_new(nls->nl80211_id, cmd, flags);
 	if (!cv)
 		return NULL;
 
@@ -273,12 +481,94 @@ nla_put_failure:
 	return NULL;
 }
 
+static int64_t nl80211_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Absolute deadline for a wait of timeout ms, -1 if it never expires */
+static int64_t nl80211_deadline(int timeout)
+{
+	return (timeout < 0) ? -1 : nl80211_now() + timeout;
+}
+
+/*
+ * Wait until fd becomes readable. Returns 0 then, -ETIMEDOUT once the
+ * deadline passed, -ECANCELED if the cancel hook of the context fired or
+ * a negative errno if polling failed.
+ */
+static int nl80211_poll(int fd, int64_t deadline)
+{
+	struct pollfd pfd = { .fd = fd, .events = POLLIN };
+	int64_t left;
+	int rv;
+
+	while (true)
+	{
+		if (lwf_ctx_cancelled())
+			return -ECANCELED;
+
+		left = NL80211_POLL_SLICE;
+
+		if (deadline >= 0)
+		{
+			if ((left = deadline - nl80211_now()) <= 0)
+				return -ETIMEDOUT;
+
+			left = min(left, NL80211_POLL_SLICE);
+		}
+
+		rv = poll(&pfd, 1, left);
+
+		if (rv > 0)
+			return 0;
+		else if (rv < 0 && errno != EINTR)
+			return -errno;
+	}
+}
+
+/*
+ * Replies to an abandoned request may still arrive and would be taken for
+ * the answer to the next one, so the request socket is replaced.
+ */
+static void nl80211_sock_reset(void)
+{
+	struct nl_sock *sock;
+	int fd;
+
+	if (!(sock = nl_socket_alloc()))
+		return;
+
+	if (genl_connect(sock))
+	{
+		nl_socket_free(sock);
+		return;
+	}
+
+	fd = nl_socket_get_fd(sock);
+	fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	nl80211_sock_acks(sock);
+
+	nl_socket_free(nls->nl_sock);
+	nls->nl_sock = sock;
+}
+
 static int nl80211_send(struct nl80211_msg_conveyor *cv,
                         int (*cb_func)(struct nl_msg *, void *),
                         void *cb_arg)
 {
-	static struct nl80211_msg_conveyor rcv;
-	int err;
+	static __thread struct nl80211_msg_conveyor rcv;
+	int64_t deadline = nl80211_deadline(lwf_ctx_timeout());
+	int err, *errp = &err;
+
+	if (cv->cb == nls->cb_pool)
+		errp = &nls->cb_pool_err;
 
 	if (cb_func)
 		nl_cb_set(cv->cb, NL_CB_VALID, NL_CB_CUSTOM, cb_func, cb_arg);
@@ -290,14 +580,28 @@ static int nl80211_send(struct nl80211_msg_conveyor *cv,
 	if (err < 0)
 		goto out;
 
-	err = 1;
+	*errp = 1;
+
+	/* the pooled callback set has these registered already */
+	if (errp == &err)
+	{
+		nl_cb_err(cv->cb,               NL_CB_CUSTOM, nl80211_msg_error,  &err);
+		nl_cb_set(cv->cb, NL_CB_FINISH, NL_CB_CUSTOM, nl80211_msg_finish, &err);
+		nl_cb_set(cv->cb, NL_CB_ACK,    NL_CB_CUSTOM, nl80211_msg_ack,    &err);
+	}
 
-	nl_cb_err(cv->cb,               NL_CB_CUSTOM, nl80211_msg_error,  &err);
-	nl_cb_set(cv->cb, NL_CB_FINISH, NL_CB_CUSTOM, nl80211_msg_finish, &err);
-	nl_cb_set(cv->cb, NL_CB_ACK,    NL_CB_CUSTOM, nl80211_msg_ack,    &err);
+	while (*errp > 0)
+	{
+		if ((err = nl80211_poll(nl_socket_get_fd(nls->nl_sock), deadline)) != 0)
+		{
+			nl80211_sock_reset();
+			goto out;
+		}
 
-	while (err > 0)
 		nl_recvmsgs(nls->nl_sock, cv->cb);
+	}
+
+	err = *errp;
 
 out:
 	nl80211_free(cv);
@@ -318,1890 +622,4416 @@ static int nl80211_request(const char *ifname, int cmd, int flags,
 	return nl80211_send(cv, cb_func, cb_arg);
 }
 
-static struct nlattr ** nl80211_parse(struct nl_msg *msg)
+
+static int nl80211_wait_seq_check(struct nl_msg *msg, void *arg)
 {
-	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
-	static struct nlattr *attr[NL80211_ATTR_MAX + 1];
+	return NL_OK;
+}
 
-	nla_parse(attr, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
-	          genlmsg_attrlen(gnlh, 0), NULL);
+/*
+ * Asynchronous requests are sent on a dedicated non-blocking socket and
+ * matched to their callbacks by sequence number when the replies arrive.
+ * The kernel runs only one dump per socket at a time and rejects further
+ * ones with EBUSY, so dumps are queued and sent once the previous finished.
+ */
+static struct nl80211_async_req * nl80211_async_find(uint32_t seq)
+{
+	struct nl80211_async_req *req;
 
-	return attr;
+	for (req = nls->async; req; req = req->next)
+		if (req->seq == seq)
+			return req;
+
+	return NULL;
 }
 
-static int nl80211_get_protocol_features_cb(struct nl_msg *msg, void *arg)
+static void nl80211_async_kick(void);
+
+static void nl80211_async_finalize(struct nl80211_async_req *req, int err)
 {
-	uint32_t *features = arg;
-	struct nlattr **attr = nl80211_parse(msg);
+	struct nl80211_async_req **prev;
 
-	if (attr[NL80211_ATTR_PROTOCOL_FEATURES])
-		*features = nla_get_u32(attr[NL80211_ATTR_PROTOCOL_FEATURES]);
+	for (prev = &nls->async; *prev != req; prev = &(*prev)->next);
 
-	return NL_SKIP;
+	*prev = req->next;
+
+	if (req->msg)
+		nl80211_msg_put(req->msg);
+	else if (req->dump)
+		nls->async_dump = false;
+
+	if (req->done)
+		req->done(err, req->arg);
+
+	free(req);
 }
 
-static int nl80211_get_protocol_features(const char *ifname)
+static void nl80211_async_complete(uint32_t seq, int err)
 {
-	struct nl80211_msg_conveyor *req;
-	uint32_t features = 0;
+	struct nl80211_async_req *req;
 
-	req = nl80211_msg(ifname, NL80211_CMD_GET_PROTOCOL_FEATURES, 0);
-	if (req) {
-		nl80211_send(req, nl80211_get_protocol_features_cb, &features);
-		nl80211_free(req);
-	}
+	for (req = nls->async; req; req = req->next)
+	{
+		/* queued requests have no sequence number yet */
+		if (req->msg || req->seq != seq)
+			continue;
 
-	return features;
+		nl80211_async_finalize(req, err);
+		nl80211_async_kick();
+		return;
+	}
 }
 
-static int nl80211_subscribe_cb(struct nl_msg *msg, void *arg)
+static void nl80211_async_abort(int err)
 {
-	struct nl80211_group_conveyor *cv = arg;
+	while (nls->async)
+		nl80211_async_finalize(nls->async, err);
 
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *mgrpinfo[CTRL_ATTR_MCAST_GRP_MAX + 1];
-	struct nlattr *mgrp;
-	int mgrpidx;
+	nls->async_dump = false;
+}
 
-	if (!attr[CTRL_ATTR_MCAST_GROUPS])
-		return NL_SKIP;
+static int nl80211_async_transmit(struct nl80211_async_req *req)
+{
+	if (nl_send_auto_complete(nls->nl_async, req->msg) < 0)
+		return -EIO;
 
-	nla_for_each_nested(mgrp, attr[CTRL_ATTR_MCAST_GROUPS], mgrpidx)
-	{
-		nla_parse(mgrpinfo, CTRL_ATTR_MCAST_GRP_MAX,
-		          nla_data(mgrp), nla_len(mgrp), NULL);
+	req->seq = nlmsg_hdr(req->msg)->nlmsg_seq;
+	nl80211_msg_put(req->msg);
+	req->msg = NULL;
 
-		if (mgrpinfo[CTRL_ATTR_MCAST_GRP_ID] &&
-		    mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME] &&
-		    !strncmp(nla_data(mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME]),
-		             cv->name, nla_len(mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME])))
-		{
-			cv->id = nla_get_u32(mgrpinfo[CTRL_ATTR_MCAST_GRP_ID]);
-			break;
-		}
-	}
+	if (req->dump)
+		nls->async_dump = true;
 
-	return NL_SKIP;
+	return 0;
 }
 
-static int nl80211_subscribe(const char *family, const char *group)
+/* Send the oldest queued dump once no other dump is running */
+static void nl80211_async_kick(void)
 {
-	struct nl80211_group_conveyor cv = { .name = group, .id = -ENOENT };
-	struct nl80211_msg_conveyor *req;
-	int err;
+	struct nl80211_async_req *req;
 
-	req = nl80211_ctl(CTRL_CMD_GETFAMILY, 0);
-	if (req)
+	while (!nls->async_dump)
 	{
-		NLA_PUT_STRING(req->msg, CTRL_ATTR_FAMILY_NAME, family);
-		err = nl80211_send(req, nl80211_subscribe_cb, &cv);
-
-		if (err)
-			return err;
+		for (req = nls->async; req && !req->msg; req = req->next);
 
-		return nl_socket_add_membership(nls->nl_sock, cv.id);
+		if (!req)
+			break;
 
-nla_put_failure:
-		nl80211_free(req);
+		if (nl80211_async_transmit(req))
+			nl80211_async_finalize(req, -EIO);
 	}
-
-	return -ENOMEM;
 }
 
-
-static int nl80211_wait_cb(struct nl_msg *msg, void *arg)
+static int nl80211_async_valid(struct nl_msg *msg, void *arg)
 {
-	struct nl80211_event_conveyor *cv = arg;
-	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nl80211_async_req *req;
+
+	req = nl80211_async_find(nlmsg_hdr(msg)->nlmsg_seq);
 
-	if (cv->wait[gnlh->cmd / 32] & (1 << (gnlh->cmd % 32)))
-		cv->recv = gnlh->cmd;
+	if (req && !req->msg && req->cb)
+		req->cb(msg, req->cb_arg);
 
 	return NL_SKIP;
 }
 
-static int nl80211_wait_seq_check(struct nl_msg *msg, void *arg)
+static int nl80211_async_finish(struct nl_msg *msg, void *arg)
 {
-	return NL_OK;
+	nl80211_async_complete(nlmsg_hdr(msg)->nlmsg_seq, 0);
+	return NL_SKIP;
 }
 
-static int __nl80211_wait(const char *family, const char *group, ...)
+static int nl80211_async_error(struct sockaddr_nl *nla,
+	struct nlmsgerr *err, void *arg)
 {
-	struct nl80211_event_conveyor cv = { };
-	struct nl_cb *cb;
-	int err = 0;
-	int cmd;
-	va_list ap;
+	nl80211_async_complete(err->msg.nlmsg_seq, err->error);
+	return NL_SKIP;
+}
 
-	if (nl80211_subscribe(family, group))
-		return -ENOENT;
+static struct nl_sock * nl80211_async_sock(void)
+{
+	struct nl_sock *sock;
+	int fd;
 
-	cb = nl_cb_alloc(NL_CB_DEFAULT);
+	if (!(sock = nl_socket_alloc()))
+		return NULL;
 
- 	if (!cb)
-		return -ENOMEM;
+	if (genl_connect(sock))
+		goto err;
 
-	nl_cb_err(cb,                  NL_CB_CUSTOM, nl80211_msg_error,      &err);
-	nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, nl80211_wait_seq_check, NULL);
-	nl_cb_set(cb, NL_CB_VALID,     NL_CB_CUSTOM, nl80211_wait_cb,        &cv );
+	fd = nl_socket_get_fd(sock);
+	if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+	    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+		goto err;
 
-	va_start(ap, group);
+	nl80211_sock_acks(sock);
 
-	for (cmd = va_arg(ap, int); cmd != 0; cmd = va_arg(ap, int))
-		cv.wait[cmd / 32] |= (1 << (cmd % 32));
+	return sock;
 
-	va_end(ap);
+err:
+	nl_socket_free(sock);
+	return NULL;
+}
 
-	while (!cv.recv && !err)
-		nl_recvmsgs(nls->nl_sock, cb);
+static int nl80211_async_init(void)
+{
+	if (nl80211_init() < 0)
+		return -ENOLINK;
 
-	nl_cb_put(cb);
+	if (nls->nl_async)
+		return 0;
 
-	return err;
-}
+	nls->nl_async = nl80211_async_sock();
+	nls->nl_async_cb = nl_cb_alloc(NL_CB_DEFAULT);
 
-#define nl80211_wait(family, group, ...) \
-	__nl80211_wait(family, group, __VA_ARGS__, 0)
-
-
-static int nl80211_freq2channel(int freq)
-{
-	if (freq == 2484)
-		return 14;
-	else if (freq < 2484)
-		return (freq - 2407) / 5;
-	else if (freq >= 4910 && freq <= 4980)
-		return (freq - 4000) / 5;
-	else
-		return (freq - 5000) / 5;
-}
+	if (!nls->nl_async || !nls->nl_async_cb)
+		goto err;
 
-static int nl80211_channel2freq(int channel, const char *band)
-{
-	if (!band || band[0] != 'a')
-	{
-		if (channel == 14)
-			return 2484;
-		else if (channel < 14)
-			return (channel * 5) + 2407;
-	}
-	else
-	{
-		if (channel >= 182 && channel <= 196)
-			return (channel * 5) + 4000;
-		else
-			return (channel * 5) + 5000;
-	}
+	/* replies of several requests interleave, the seq is checked above */
+	nl_cb_set(nls->nl_async_cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM,
+	          nl80211_wait_seq_check, NULL);
+	nl_cb_set(nls->nl_async_cb, NL_CB_VALID,  NL_CB_CUSTOM,
+	          nl80211_async_valid, NULL);
+	nl_cb_set(nls->nl_async_cb, NL_CB_FINISH, NL_CB_CUSTOM,
+	          nl80211_async_finish, NULL);
+	nl_cb_set(nls->nl_async_cb, NL_CB_ACK,    NL_CB_CUSTOM,
+	          nl80211_async_finish, NULL);
+	nl_cb_err(nls->nl_async_cb, NL_CB_CUSTOM, nl80211_async_error, NULL);
 
 	return 0;
-}
 
-static int nl80211_ifname2phy_cb(struct nl_msg *msg, void *arg)
-{
-	char *buf = arg;
-	struct nlattr **attr = nl80211_parse(msg);
+err:
+	if (nls->nl_async_cb)
+		nl_cb_put(nls->nl_async_cb);
 
-	if (attr[NL80211_ATTR_WIPHY_NAME])
-		memcpy(buf, nla_data(attr[NL80211_ATTR_WIPHY_NAME]),
-		       nla_len(attr[NL80211_ATTR_WIPHY_NAME]));
-	else
-		buf[0] = 0;
+	if (nls->nl_async)
+		nl_socket_free(nls->nl_async);
 
-	return NL_SKIP;
+	nls->nl_async_cb = NULL;
+	nls->nl_async = NULL;
+
+	return -ENOLINK;
 }
 
-static char * nl80211_ifname2phy(const char *ifname)
+/*
+ * The rest of an abandoned dump would still arrive and keep the kernel from
+ * starting the next one, so the async socket is replaced. Requests already
+ * sent on it can not complete anymore, queued ones go out on the new one.
+ */
+static void nl80211_async_reset(void)
 {
-	static char phy[32] = { 0 };
+	struct nl80211_async_req *req, *next;
+	struct nl_sock *sock;
 
-	memset(phy, 0, sizeof(phy));
+	for (req = nls->async; req; req = next)
+	{
+		next = req->next;
 
-	nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
-	                nl80211_ifname2phy_cb, phy);
+		if (!req->msg)
+			nl80211_async_finalize(req, -EAGAIN);
+	}
 
-	return phy[0] ? phy : NULL;
-}
+	nls->async_dump = false;
 
-static char * nl80211_phy2ifname(const char *ifname)
-{
-	int ifidx = -1, cifidx = -1, phyidx = -1;
-	char buffer[64];
-	static char nif[IFNAMSIZ] = { 0 };
+	if ((sock = nl80211_async_sock()) != NULL)
+	{
+		nl_socket_free(nls->nl_async);
+		nls->nl_async = sock;
+	}
 
-	DIR *d;
-	struct dirent *e;
+	nl80211_async_kick();
+}
 
-	/* Only accept phy name of the form phy%d */
-	if (!ifname)
-		return NULL;
-	else if (!strncmp(ifname, "phy", 3))
-		phyidx = atoi(&ifname[3]);
-	else
-		return NULL;
+static int nl80211_async_send(struct nl80211_msg_conveyor *cv,
+                              int (*cb_func)(struct nl_msg *, void *),
+                              void *cb_arg, void (*done)(int, void *),
+                              void *arg)
+{
+	struct nl80211_async_req *req, **tail;
+	int err;
 
-	memset(nif, 0, sizeof(nif));
+	if ((err = nl80211_async_init()) != 0)
+		goto out;
 
-	if (phyidx > -1)
+	if (!(req = calloc(1, sizeof(*req))))
 	{
-		if ((d = opendir("/sys/class/net")) != NULL)
-		{
-			while ((e = readdir(d)) != NULL)
-			{
-				snprintf(buffer, sizeof(buffer),
-				         "/sys/class/net/%s/phy80211/index", e->d_name);
+		err = -ENOMEM;
+		goto out;
+	}
 
-				if (nl80211_readint(buffer) == phyidx)
-				{
-					snprintf(buffer, sizeof(buffer),
-					         "/sys/class/net/%s/ifindex", e->d_name);
+	req->msg    = cv->msg;
+	req->dump   = !!(nlmsg_hdr(cv->msg)->nlmsg_flags & NLM_F_DUMP);
+	req->cb     = cb_func;
+	req->cb_arg = cb_arg;
+	req->done   = done;
+	req->arg    = arg;
 
-					if ((cifidx = nl80211_readint(buffer)) >= 0 &&
-					    ((ifidx < 0) || (cifidx < ifidx)))
-					{
-						ifidx = cifidx;
-						strncpy(nif, e->d_name, sizeof(nif) - 1);
-					}
-				}
-			}
+	cv->msg = NULL;
 
-			closedir(d);
+	/* keep submission order, queued dumps are sent oldest first */
+	for (tail = &nls->async; *tail; tail = &(*tail)->next);
+	*tail = req;
+
+	if (!req->dump || !nls->async_dump)
+	{
+		if ((err = nl80211_async_transmit(req)) != 0)
+		{
+			req->done = NULL;
+			nl80211_async_finalize(req, err);
 		}
 	}
 
-	return nif[0] ? nif : NULL;
+out:
+	nl80211_free(cv);
+	return err;
 }
 
-static int nl80211_get_mode_cb(struct nl_msg *msg, void *arg)
+static int nl80211_async_request(const char *ifname, int cmd, int flags,
+                                 int (*cb_func)(struct nl_msg *, void *),
+                                 void *cb_arg, void (*done)(int, void *),
+                                 void *arg)
 {
-	int *mode = arg;
-	struct nlattr **tb = nl80211_parse(msg);
-	const int ifmodes[NL80211_IFTYPE_MAX + 1] = {
-		LWF_OPMODE_UNKNOWN,		/* unspecified */
-		LWF_OPMODE_ADHOC,		/* IBSS */
-		LWF_OPMODE_CLIENT,		/* managed */
-		LWF_OPMODE_MASTER,		/* AP */
-		LWF_OPMODE_AP_VLAN,		/* AP/VLAN */
-		LWF_OPMODE_WDS,			/* WDS */
-		LWF_OPMODE_MONITOR,		/* monitor */
-		LWF_OPMODE_MESHPOINT,	/* mesh point */
-		LWF_OPMODE_P2P_CLIENT,	/* P2P-client */
-		LWF_OPMODE_P2P_GO,		/* P2P-GO */
-	};
+	struct nl80211_msg_conveyor *cv;
 
-	if (tb[NL80211_ATTR_IFTYPE])
-		*mode = ifmodes[nla_get_u32(tb[NL80211_ATTR_IFTYPE])];
+	cv = nl80211_msg(ifname, cmd, flags);
 
-	return NL_SKIP;
-}
+	if (!cv)
+		return -ENOMEM;
 
+	return nl80211_async_send(cv, cb_func, cb_arg, done, arg);
+}
 
-static int nl80211_get_mode(const char *ifname, int *buf)
+static int nl80211_async_fd(void)
 {
-	char *res;
-
-	*buf = LWF_OPMODE_UNKNOWN;
-
-	res = nl80211_phy2ifname(ifname);
+	int err;
 
-	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
-	                nl80211_get_mode_cb, buf);
+	if ((err = nl80211_async_init()) != 0)
+		return err;
 
-	return (*buf == LWF_OPMODE_UNKNOWN) ? -1 : 0;
+	return nl_socket_get_fd(nls->nl_async);
 }
 
-static int __nl80211_hostapd_query(const char *ifname, ...)
+static int nl80211_async_process(void)
 {
-	va_list ap, ap_cur;
-	char *phy, *search, *dest, *key, *val, buf[128];
-	int len, mode, found = 0, match = 1;
-	FILE *fp;
+	struct pollfd pfd = { .events = POLLIN };
+	int err;
 
-	if (nl80211_get_mode(ifname, &mode))
+	if (!nls || !nls->nl_async)
 		return 0;
 
-	if (mode != LWF_OPMODE_MASTER && mode != LWF_OPMODE_AP_VLAN)
-		return 0;
+	pfd.fd = nl_socket_get_fd(nls->nl_async);
 
-	phy = nl80211_ifname2phy(ifname);
+	while (nls->async && poll(&pfd, 1, 0) > 0)
+	{
+		err = nl_recvmsgs(nls->nl_async, nls->nl_async_cb);
 
-	if (!phy)
-		return 0;
+		/* replies were lost, nothing pending can complete anymore */
+		if (err < 0 && err != -NLE_AGAIN)
+		{
+			nl80211_async_abort(-EIO);
+			return -EIO;
+		}
+	}
 
-	snprintf(buf, sizeof(buf), "/var/run/hostapd-%s.conf", phy);
-	fp = fopen(buf, "r");
+	return 0;
+}
 
-	if (!fp)
-		return 0;
+/*
+ * A batch sends several requests back to back over the async socket and
+ * then waits for all of them, instead of one round trip per request.
+ */
+static void nl80211_batch_done(int err, void *arg)
+{
+	struct nl80211_batch_req *r = arg;
 
-	va_start(ap, ifname);
+	r->err = err;
+	r->batch->pending--;
+}
 
-	/* clear all destination buffers */
-	va_copy(ap_cur, ap);
+static struct nl80211_batch_req * nl80211_batch_add(struct nl80211_batch *b,
+	const char *ifname, int cmd, int flags,
+	int (*cb_func)(struct nl_msg *, void *), void *cb_arg)
+{
+	struct nl80211_batch_req *r;
 
-	while ((search = va_arg(ap_cur, char *)) != NULL)
-	{
-		dest = va_arg(ap_cur, char *);
-		len  = va_arg(ap_cur, int);
+	if (!(r = calloc(1, sizeof(*r))))
+		return NULL;
 
-		memset(dest, 0, len);
+	r->batch = b;
+	r->next = b->reqs;
+	b->reqs = r;
+
+	r->err = nl80211_async_request(ifname, cmd, flags, cb_func, cb_arg,
+	                               nl80211_batch_done, r);
+
+	if (!r->err)
+	{
+		r->err = -EINPROGRESS;
+		b->pending++;
 	}
 
-	va_end(ap_cur);
+	return r;
+}
 
-	/* iterate applicable lines and copy found values into dest buffers */
-	while (fgets(buf, sizeof(buf), fp))
+/*
+ * Give up on the requests of a batch only, other async requests stay
+ * pending unless the socket has to be replaced for an abandoned dump.
+ */
+static void nl80211_batch_abort(struct nl80211_batch *b, int err)
+{
+	struct nl80211_async_req *req, *next;
+	struct nl80211_batch_req *r;
+	bool reset = false;
+
+	for (req = nls->async; req; req = next)
 	{
-		key = strtok(buf, " =\t\n");
-		val = strtok(NULL, "\n");
+		next = req->next;
 
-		if (!key || !val || !*key || *key == '#')
+		if (req->done != nl80211_batch_done)
 			continue;
 
-		if (!strcmp(key, "interface") || !strcmp(key, "bss"))
-			match = !strcmp(ifname, val);
+		r = req->arg;
 
-		if (!match)
+		if (r->batch != b)
 			continue;
 
-		va_copy(ap_cur, ap);
+		if (!req->msg && req->dump)
+			reset = true;
 
-		while ((search = va_arg(ap_cur, char *)) != NULL)
-		{
-			dest = va_arg(ap_cur, char *);
-			len  = va_arg(ap_cur, int);
+		nl80211_async_finalize(req, err);
+	}
 
-			if (!strcmp(search, key))
-			{
-				strncpy(dest, val, len - 1);
-				found++;
-				break;
-			}
-		}
+	if (reset)
+		nl80211_async_reset();
+	else
+		nl80211_async_kick();
+}
 
-		va_end(ap_cur);
-	}
+static int nl80211_batch_run(struct nl80211_batch *b)
+{
+	int64_t deadline = nl80211_deadline(lwf_ctx_timeout());
+	int err = 0;
 
-	fclose(fp);
+	while (b->pending > 0)
+	{
+		if ((err = nl80211_poll(nl_socket_get_fd(nls->nl_async), deadline)) != 0)
+		{
+			nl80211_batch_abort(b, err);
+			break;
+		}
 
-	va_end(ap);
+		nl80211_async_process();
+	}
 
-	return found;
+	return err;
 }
 
-#define nl80211_hostapd_query(ifname, ...) \
-	__nl80211_hostapd_query(ifname, ##__VA_ARGS__, NULL)
+static void nl80211_batch_free(struct nl80211_batch *b)
+{
+	struct nl80211_batch_req *r, *next;
+
+	for (r = b->reqs; r; r = next)
+	{
+		next = r->next;
+		free(r);
+	}
 
+	b->reqs = NULL;
+}
 
-static inline int nl80211_wpactl_recv(int sock, char *buf, int blen)
+static struct nlattr ** nl80211_parse(struct nl_msg *msg)
 {
-	fd_set rfds;
-	struct timeval tv = { 0, 256000 };
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	static __thread struct nlattr *attr[NL80211_ATTR_MAX + 1];
 
-	FD_ZERO(&rfds);
-	FD_SET(sock, &rfds);
+	nla_parse(attr, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+	          genlmsg_attrlen(gnlh, 0), NULL);
 
-	memset(buf, 0, blen);
+	return attr;
+}
 
-	if (select(sock + 1, &rfds, NULL, NULL, &tv) < 0)
-		return -1;
+static int nl80211_get_protocol_features_cb(struct nl_msg *msg, void *arg)
+{
+	uint32_t *features = arg;
+	struct nlattr **attr = nl80211_parse(msg);
 
-	if (!FD_ISSET(sock, &rfds))
-		return -1;
+	if (attr[NL80211_ATTR_PROTOCOL_FEATURES])
+		*features = nla_get_u32(attr[NL80211_ATTR_PROTOCOL_FEATURES]);
 
-	return recv(sock, buf, blen - 1, 0);
+	return NL_SKIP;
 }
 
-static int nl80211_wpactl_connect(const char *ifname, struct sockaddr_un *local)
+static int nl80211_get_protocol_features(const char *ifname)
 {
-	struct sockaddr_un remote = { 0 };
-	size_t remote_length, local_length;
+	struct nl80211_msg_conveyor *req;
+	uint32_t features = 0;
 
-	int sock = socket(PF_UNIX, SOCK_DGRAM, 0);
-	if (sock < 0)
-		return sock;
+	/* protocol features are global to nl80211, query them only once */
+	if (nls && nls->features_valid)
+		return nls->features;
 
-	remote.sun_family = AF_UNIX;
-	remote_length = sizeof(remote.sun_family) +
-		sprintf(remote.sun_path, "/var/run/wpa_supplicant-%s/%s",
-		        ifname, ifname);
+	req = nl80211_msg(ifname, NL80211_CMD_GET_PROTOCOL_FEATURES, 0);
+	if (req) {
+		if (!nl80211_send(req, nl80211_get_protocol_features_cb, &features))
+		{
+			nls->features = features;
+			nls->features_valid = true;
+		}
 
-	if (fcntl(sock, F_SETFD, fcntl(sock, F_GETFD) | FD_CLOEXEC) < 0)
-	{
-		close(sock);
-		return -1;
+		nl80211_free(req);
 	}
 
-	if (connect(sock, (struct sockaddr *)&remote, remote_length))
+	return features;
+}
+
+static int nl80211_subscribe_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_group_conveyor *cv = arg;
+
+	struct nlattr **attr = nl80211_parse(msg);
+	struct nlattr *mgrpinfo[CTRL_ATTR_MCAST_GRP_MAX + 1];
+	struct nlattr *mgrp;
+	int mgrpidx;
+
+	if (!attr[CTRL_ATTR_MCAST_GROUPS])
+		return NL_SKIP;
+
+	nla_for_each_nested(mgrp, attr[CTRL_ATTR_MCAST_GROUPS], mgrpidx)
 	{
-		remote_length = sizeof(remote.sun_family) +
-			sprintf(remote.sun_path, "/var/run/wpa_supplicant/%s", ifname);
+		nla_parse(mgrpinfo, CTRL_ATTR_MCAST_GRP_MAX,
+		          nla_data(mgrp), nla_len(mgrp), NULL);
 
-		if (connect(sock, (struct sockaddr *)&remote, remote_length))
+		if (mgrpinfo[CTRL_ATTR_MCAST_GRP_ID] &&
+		    mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME] &&
+		    !strncmp(nla_data(mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME]),
+		             cv->name, nla_len(mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME])))
 		{
-			close(sock);
-			return -1;
+			cv->id = nla_get_u32(mgrpinfo[CTRL_ATTR_MCAST_GRP_ID]);
+			break;
 		}
 	}
 
-	local->sun_family = AF_UNIX;
-	local_length = sizeof(local->sun_family) +
-		sprintf(local->sun_path, "/var/run/lwf-%s-%d", ifname, getpid());
+	return NL_SKIP;
+}
 
-	if (bind(sock, (struct sockaddr *)local, local_length) < 0)
+static int nl80211_family_cb(struct nl_msg *msg, void *arg)
+{
+	struct nlattr **attr = nl80211_parse(msg);
+	struct nlattr *mgrpinfo[CTRL_ATTR_MCAST_GRP_MAX + 1];
+	struct nlattr *mgrp;
+	struct nl80211_mcast_group *g;
+	int mgrpidx;
+
+	if (attr[CTRL_ATTR_FAMILY_ID])
+		nls->nl80211_id = nla_get_u16(attr[CTRL_ATTR_FAMILY_ID]);
+
+	if (!attr[CTRL_ATTR_MCAST_GROUPS])
+		return NL_SKIP;
+
+	nla_for_each_nested(mgrp, attr[CTRL_ATTR_MCAST_GROUPS], mgrpidx)
 	{
-		close(sock);
-		return -1;
+		if (nls->groups_count >= NL80211_MCAST_GROUPS)
+			break;
+
+		nla_parse(mgrpinfo, CTRL_ATTR_MCAST_GRP_MAX,
+		          nla_data(mgrp), nla_len(mgrp), NULL);
+
+		if (!mgrpinfo[CTRL_ATTR_MCAST_GRP_ID] ||
+		    !mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME])
+			continue;
+
+		g = &nls->groups[nls->groups_count++];
+		g->id = nla_get_u32(mgrpinfo[CTRL_ATTR_MCAST_GRP_ID]);
+		strncpy(g->name, nla_get_string(mgrpinfo[CTRL_ATTR_MCAST_GRP_NAME]),
+		        sizeof(g->name) - 1);
 	}
 
-	return sock;
+	return NL_SKIP;
 }
 
-static int __nl80211_wpactl_query(const char *ifname, ...)
+/*
+ * Look up the nl80211 family id and its multicast groups with a single
+ * GETFAMILY request, they stay valid for the life of the socket.
+ */
+static int nl80211_resolve_family(void)
 {
-	va_list ap, ap_cur;
-	struct sockaddr_un local = { 0 };
-	int len, mode, found = 0, sock = -1;
-	char *search, *dest, *key, *val, *line, *pos, buf[512];
+	struct nl80211_msg_conveyor *req;
 
-	if (nl80211_get_mode(ifname, &mode))
-		return 0;
+	req = nl80211_new(GENL_ID_CTRL, CTRL_CMD_GETFAMILY, 0);
+	if (!req)
+		return -ENOMEM;
 
-	if (mode != LWF_OPMODE_CLIENT && mode != LWF_OPMODE_ADHOC)
-		return 0;
+	NLA_PUT_STRING(req->msg, CTRL_ATTR_FAMILY_NAME, "nl80211");
 
-	sock = nl80211_wpactl_connect(ifname, &local);
+	if (nl80211_send(req, nl80211_family_cb, NULL) || !nls->nl80211_id)
+		return -ENOENT;
 
-	if (sock < 0)
-		return 0;
+	return 0;
 
-	va_start(ap, ifname);
+nla_put_failure:
+	nl80211_free(req);
+	return -ENOMEM;
+}
 
-	/* clear all destination buffers */
-	va_copy(ap_cur, ap);
+static int nl80211_get_group(const char *family, const char *group)
+{
+	struct nl80211_group_conveyor cv = { .name = group, .id = -ENOENT };
+	struct nl80211_msg_conveyor *req;
+	int i, err;
 
-	while ((search = va_arg(ap_cur, char *)) != NULL)
+	if (!strcmp(family, "nl80211") && nl80211_init() == 0)
 	{
-		dest = va_arg(ap_cur, char *);
-		len  = va_arg(ap_cur, int);
+		for (i = 0; i < nls->groups_count; i++)
+			if (!strcmp(nls->groups[i].name, group))
+				return nls->groups[i].id;
 
-		memset(dest, 0, len);
+		return -ENOENT;
 	}
 
-	va_end(ap_cur);
+	req = nl80211_ctl(CTRL_CMD_GETFAMILY, 0);
+	if (req)
+	{
+		NLA_PUT_STRING(req->msg, CTRL_ATTR_FAMILY_NAME, family);
+		err = nl80211_send(req, nl80211_subscribe_cb, &cv);
 
-	send(sock, "STATUS", 6, 0);
+		if (err)
+			return err;
 
-	while (true)
-	{
-		if (nl80211_wpactl_recv(sock, buf, sizeof(buf)) <= 0)
-			break;
+		return cv.id;
 
-		if (buf[0] == '<')
-			continue;
+nla_put_failure:
+		nl80211_free(req);
+	}
 
-		for (line = strtok_r(buf, "\n", &pos);
-			 line != NULL;
-			 line = strtok_r(NULL, "\n", &pos))
-		{
-			key = strtok(line, "=");
-			val = strtok(NULL, "\n");
+	return -ENOMEM;
+}
 
-			if (!key || !val)
-				continue;
+static int nl80211_wait_init(void)
+{
+	int fd;
 
-			va_copy(ap_cur, ap);
+	if (nls->nl_wait)
+		return 0;
 
-			while ((search = va_arg(ap_cur, char *)) != NULL)
-			{
-				dest = va_arg(ap_cur, char *);
-				len  = va_arg(ap_cur, int);
+	nls->nl_wait = nl_socket_alloc();
+	nls->nl_wait_cb = nl_cb_alloc(NL_CB_DEFAULT);
 
-				if (!strcmp(search, key))
-				{
-					strncpy(dest, val, len - 1);
-					found++;
-					break;
-				}
-			}
+	if (!nls->nl_wait || !nls->nl_wait_cb)
+		goto err;
 
-			va_end(ap_cur);
-		}
+	if (genl_connect(nls->nl_wait))
+		goto err;
 
-		break;
-	}
+	fd = nl_socket_get_fd(nls->nl_wait);
+	if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+	    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+		goto err;
 
-	va_end(ap);
+	nl_socket_set_buffer_size(nls->nl_wait, NL80211_EVENT_RCVBUF, 0);
 
-	close(sock);
-	unlink(local.sun_path);
+	nl_cb_set(nls->nl_wait_cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM,
+	          nl80211_wait_seq_check, NULL);
 
-	return found;
-}
+	return 0;
 
-#define nl80211_wpactl_query(ifname, ...) \
-	__nl80211_wpactl_query(ifname, ##__VA_ARGS__, NULL)
+err:
+	if (nls->nl_wait_cb)
+		nl_cb_put(nls->nl_wait_cb);
 
+	if (nls->nl_wait)
+		nl_socket_free(nls->nl_wait);
 
-static char * nl80211_ifadd(const char *ifname)
+	nls->nl_wait_cb = NULL;
+	nls->nl_wait = NULL;
+
+	return -ENOLINK;
+}
+
+static void nl80211_scan_done_mark(int phyidx)
 {
-	char path[PATH_MAX];
-	static char nif[IFNAMSIZ] = { 0 };
-	struct nl80211_msg_conveyor *req;
-	FILE *sysfs;
+	struct nl80211_scan_done *d;
 
-	req = nl80211_msg(ifname, NL80211_CMD_NEW_INTERFACE, 0);
-	if (req)
+	for (d = nls->scan_done; d; d = d->next)
+		if (d->phyidx == phyidx)
+			break;
+
+	if (!d)
 	{
-		snprintf(nif, sizeof(nif), "tmp.%s", ifname);
+		if (!(d = calloc(1, sizeof(*d))))
+			return;
 
-		NLA_PUT_STRING(req->msg, NL80211_ATTR_IFNAME, nif);
-		NLA_PUT_U32(req->msg, NL80211_ATTR_IFTYPE, NL80211_IFTYPE_STATION);
+		d->phyidx = phyidx;
+		d->next = nls->scan_done;
+		nls->scan_done = d;
+	}
 
-		nl80211_send(req, NULL, NULL);
+	d->ts = nl80211_now();
+}
 
-		snprintf(path, sizeof(path) - 1,
-		         "/proc/sys/net/ipv6/conf/%s/disable_ipv6", nif);
+/*
+ * Whether a scan of the phy, by any process, completed just now. Only
+ * completions arriving while this context had a scan of the phy in flight
+ * are recorded, older ones are read late and say nothing about their age.
+ */
+static bool nl80211_scan_recent(int phyidx)
+{
+	struct nl80211_scan_done *d;
 
-		if ((sysfs = fopen(path, "w")) != NULL)
-		{
-			fwrite("0\n", 1, 2, sysfs);
-			fclose(sysfs);
-		}
+	for (d = nls->scan_done; d; d = d->next)
+		if (d->phyidx == phyidx)
+			return (nl80211_now() - d->ts < NL80211_SCAN_REUSE);
 
-		return nif;
+	return false;
+}
 
-	nla_put_failure:
-		nl80211_free(req);
+static void nl80211_scan_done_free(void)
+{
+	struct nl80211_scan_done *d, *next;
+
+	for (d = nls->scan_done; d; d = next)
+	{
+		next = d->next;
+		free(d);
 	}
 
-	return NULL;
+	nls->scan_done = NULL;
 }
 
-static void nl80211_ifdel(const char *ifname)
+/*
+ * Scan completions are consumed by whoever drains the wait socket, so they
+ * are recorded on the pending asynchronous scans of the interface first.
+ * Scans which found the phy busy complete with the one already running.
+ */
+static void nl80211_scan_event(struct nl_msg *msg)
 {
-	struct nl80211_msg_conveyor *req;
-	int err;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr **attr;
+	struct nl80211_scan *s;
+	int ifidx = 0, phyidx = -1;
 
-	req = nl80211_msg(ifname, NL80211_CMD_DEL_INTERFACE, 0);
-	if (req)
+	if (gnlh->cmd != NL80211_CMD_NEW_SCAN_RESULTS &&
+	    gnlh->cmd != NL80211_CMD_SCAN_ABORTED)
+		return;
+
+	attr = nl80211_parse(msg);
+
+	if (attr[NL80211_ATTR_IFINDEX])
+		ifidx = nla_get_u32(attr[NL80211_ATTR_IFINDEX]);
+
+	if (attr[NL80211_ATTR_WIPHY])
+		phyidx = nla_get_u32(attr[NL80211_ATTR_WIPHY]);
+
+	for (s = nls->scans; s; s = s->next)
 	{
-		NLA_PUT_STRING(req->msg, NL80211_ATTR_IFNAME, ifname);
+		if (s->event)
+			continue;
 
-		nl80211_send(req, NULL, NULL);
-		return;
+		if (gnlh->cmd == NL80211_CMD_NEW_SCAN_RESULTS && phyidx >= 0 &&
+		    s->phyidx == phyidx)
+			nl80211_scan_done_mark(phyidx);
 
-	nla_put_failure:
-		nl80211_free(req);
+		if ((ifidx && s->ifidx == ifidx) ||
+		    (s->busy && phyidx >= 0 && s->phyidx == phyidx))
+			s->event = gnlh->cmd;
 	}
 }
 
-static void nl80211_hostapd_hup(const char *ifname)
+static int nl80211_scan_event_cb(struct nl_msg *msg, void *arg)
 {
-	int fd, pid = 0;
-	char buf[32];
-	char *phy = nl80211_ifname2phy(ifname);
+	nl80211_scan_event(msg);
+	return NL_SKIP;
+}
 
-	if (phy)
+/*
+ * Join the multicast group on the wait socket and drop stale notifications,
+ * to be called before triggering the operation whose completion is awaited
+ * so that a fast completion can not be missed. Memberships stay on the wait
+ * socket, the request socket never receives events.
+ */
+static int nl80211_wait_prepare(const char *family, const char *group)
+{
+	struct pollfd pfd = { .events = POLLIN };
+	int i, id;
+
+	if ((id = nl80211_get_group(family, group)) < 0)
+		return id;
+
+	if (nl80211_wait_init())
+		return -ENOLINK;
+
+	for (i = 0; i < nls->groups_count; i++)
 	{
-		snprintf(buf, sizeof(buf), "/var/run/wifi-%s.pid", phy);
-		if ((fd = open(buf, O_RDONLY)) >= 0)
+		if (nls->groups[i].id != id)
+			continue;
+
+		if (!nls->groups[i].wait_joined)
 		{
-			if (read(fd, buf, sizeof(buf)) > 0)
-				pid = atoi(buf);
+			if (nl_socket_add_membership(nls->nl_wait, id))
+				return -ENOLINK;
 
-			close(fd);
+			nls->groups[i].wait_joined = true;
 		}
 
-		if (pid > 0)
-			kill(pid, 1);
+		break;
 	}
-}
 
+	nl_cb_set(nls->nl_wait_cb, NL_CB_VALID, NL_CB_CUSTOM,
+	          nl80211_scan_event_cb, NULL);
 
-static int nl80211_probe(const char *ifname)
-{
-	return !!nl80211_ifname2phy(ifname);
+	pfd.fd = nl_socket_get_fd(nls->nl_wait);
+
+	while (poll(&pfd, 1, 0) > 0)
+		if (nl_recvmsgs(nls->nl_wait, nls->nl_wait_cb) < 0)
+			break;
+
+	return 0;
 }
 
-struct nl80211_ssid_bssid {
-	unsigned char *ssid;
-	unsigned char bssid[7];
-};
 
-static int nl80211_get_macaddr_cb(struct nl_msg *msg, void *arg)
+static int nl80211_wait_cb(struct nl_msg *msg, void *arg)
 {
-	struct nl80211_ssid_bssid *sb = arg;
-	struct nlattr **tb = nl80211_parse(msg);
-
-	if (tb[NL80211_ATTR_MAC]) {
-		sb->bssid[0] = 1;
-		memcpy(sb->bssid + 1, nla_data(tb[NL80211_ATTR_MAC]),
-		       sizeof(sb->bssid) - 1);
-	}
-
-	return NL_SKIP;
-}
-
-static int nl80211_get_ssid_bssid_cb(struct nl_msg *msg, void *arg)
-{
-	int ielen;
-	unsigned char *ie;
-	struct nl80211_ssid_bssid *sb = arg;
-	struct nlattr **tb = nl80211_parse(msg);
-	struct nlattr *bss[NL80211_BSS_MAX + 1];
+	struct nl80211_event_conveyor *cv = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr **attr;
 
-	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
-		[NL80211_BSS_INFORMATION_ELEMENTS] = { 0 },
-		[NL80211_BSS_STATUS]               = { .type = NLA_U32 },
-	};
+	nl80211_scan_event(msg);
 
-	if (!tb[NL80211_ATTR_BSS] ||
-	    nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS],
-	                     bss_policy) ||
-	    !bss[NL80211_BSS_BSSID] ||
-	    !bss[NL80211_BSS_STATUS] ||
-	    !bss[NL80211_BSS_INFORMATION_ELEMENTS])
-	{
+	if (!(cv->wait[gnlh->cmd / 32] & (1 << (gnlh->cmd % 32))))
 		return NL_SKIP;
-	}
 
-	switch (nla_get_u32(bss[NL80211_BSS_STATUS]))
+	/* ignore completions of other interfaces or phys */
+	if (cv->ifidx > 0 || cv->phyidx >= 0)
 	{
-	case NL80211_BSS_STATUS_ASSOCIATED:
-	case NL80211_BSS_STATUS_AUTHENTICATED:
-	case NL80211_BSS_STATUS_IBSS_JOINED:
-
-		if (sb->ssid)
-		{
-			ie = nla_data(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
-			ielen = nla_len(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
-
-			while (ielen >= 2 && ielen >= ie[1])
-			{
-				if (ie[0] == 0)
-				{
-					memcpy(sb->ssid, ie + 2, min(ie[1], LWF_ESSID_MAX_SIZE));
-					return NL_SKIP;
-				}
+		attr = nl80211_parse(msg);
 
-				ielen -= ie[1] + 2;
-				ie += ie[1] + 2;
-			}
-		}
-		else
-		{
-			sb->bssid[0] = 1;
-			memcpy(sb->bssid + 1, nla_data(bss[NL80211_BSS_BSSID]), 6);
+		if (cv->ifidx > 0 && attr[NL80211_ATTR_IFINDEX] &&
+		    nla_get_u32(attr[NL80211_ATTR_IFINDEX]) != cv->ifidx)
 			return NL_SKIP;
-		}
 
-	default:
-		return NL_SKIP;
+		if (cv->phyidx >= 0 && attr[NL80211_ATTR_WIPHY] &&
+		    nla_get_u32(attr[NL80211_ATTR_WIPHY]) != cv->phyidx)
+			return NL_SKIP;
 	}
-}
 
-static int nl80211_get_ssid(const char *ifname, char *buf)
-{
-	char *res;
-	struct nl80211_ssid_bssid sb = { .ssid = (unsigned char *)buf };
+	cv->recv = gnlh->cmd;
 
-	/* try to find ssid from scan dump results */
-	res = nl80211_phy2ifname(ifname);
-	sb.ssid[0] = 0;
+	return NL_SKIP;
+}
 
-	nl80211_request(res ? res : ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
-	                nl80211_get_ssid_bssid_cb, &sb);
+/*
+ * Wait for one of the given commands on the wait socket, a group must have
+ * been joined with nl80211_wait_prepare() first. Events are matched against
+ * the interface if given and against the phy if phyidx is not negative.
+ * If the socket overran the
+ * awaited event may be lost, the wait ends then and the caller is expected
+ * to resync by dumping the current state.
+ */
+static int __nl80211_wait(const char *ifname, int phyidx, int timeout, ...)
+{
+	struct nl80211_event_conveyor cv = { .phyidx = phyidx };
+	int64_t deadline = nl80211_deadline(timeout);
+	int err = 0;
+	int cmd;
+	va_list ap;
 
-	/* failed, try to find from hostapd info */
-	if (sb.ssid[0] == 0)
-		nl80211_hostapd_query(ifname, "ssid", sb.ssid,
-		                      LWF_ESSID_MAX_SIZE + 1);
+	if (!nls || !nls->nl_wait)
+		return -ENOENT;
 
-	return (sb.ssid[0] == 0) ? -1 : 0;
-}
+	cv.ifidx = ifname ? nl80211_ifindex(ifname) : 0;
 
-static int nl80211_get_bssid(const char *ifname, char *buf)
-{
-	char *res, bssid[sizeof("FF:FF:FF:FF:FF:FF\0")];
-	struct nl80211_ssid_bssid sb = { };
+	nl_cb_set(nls->nl_wait_cb, NL_CB_VALID, NL_CB_CUSTOM, nl80211_wait_cb, &cv);
 
-	res = nl80211_phy2ifname(ifname);
+	va_start(ap, timeout);
 
-	/* try to obtain mac address via NL80211_CMD_GET_INTERFACE */
-	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
-	                nl80211_get_macaddr_cb, &sb);
+	for (cmd = va_arg(ap, int); cmd != 0; cmd = va_arg(ap, int))
+		cv.wait[cmd / 32] |= (1 << (cmd % 32));
 
-	/* failed, try to find bssid from scan dump results */
-	if (sb.bssid[0] == 0)
-		nl80211_request(res ? res : ifname,
-		                NL80211_CMD_GET_SCAN, NLM_F_DUMP,
-		                nl80211_get_ssid_bssid_cb, &sb);
+	va_end(ap);
 
-	/* failed, try to find mac from hostapd info */
-	if ((sb.bssid[0] == 0) &&
-	    nl80211_hostapd_query(ifname, "bssid", bssid, sizeof(bssid)))
+	while (!cv.recv)
 	{
-		sb.bssid[0] = 1;
-		sb.bssid[1] = strtol(&bssid[0],  NULL, 16);
-		sb.bssid[2] = strtol(&bssid[3],  NULL, 16);
-		sb.bssid[3] = strtol(&bssid[6],  NULL, 16);
-		sb.bssid[4] = strtol(&bssid[9],  NULL, 16);
-		sb.bssid[5] = strtol(&bssid[12], NULL, 16);
-		sb.bssid[6] = strtol(&bssid[15], NULL, 16);
-	}
+		if ((err = nl80211_poll(nl_socket_get_fd(nls->nl_wait), deadline)) != 0)
+			break;
 
-	if (sb.bssid[0])
-	{
-		sprintf(buf, "%02X:%02X:%02X:%02X:%02X:%02X",
-		        sb.bssid[1], sb.bssid[2], sb.bssid[3],
-		        sb.bssid[4], sb.bssid[5], sb.bssid[6]);
+		err = nl_recvmsgs(nls->nl_wait, nls->nl_wait_cb);
 
-		return 0;
+		/* events were lost, treat as completed and let the caller resync */
+		if (err < 0 && err != -NLE_AGAIN)
+		{
+			err = 0;
+			break;
+		}
+
+		err = 0;
 	}
 
-	return -1;
+	return err;
 }
 
+#define nl80211_wait(ifname, timeout, ...) \
+	__nl80211_wait(ifname, -1, timeout, __VA_ARGS__, 0)
 
-static int nl80211_get_frequency_scan_cb(struct nl_msg *msg, void *arg)
+#define nl80211_wait_phy(phyidx, timeout, ...) \
+	__nl80211_wait(NULL, phyidx, timeout, __VA_ARGS__, 0)
+
+
+static void nl80211_sta_watch_event(int cmd, struct nlattr **attr);
+
+static int nl80211_events_cb(struct nl_msg *msg, void *arg)
 {
-	int *freq = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
 	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *binfo[NL80211_BSS_MAX + 1];
+	int phyidx = -1;
 
-	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
-		[NL80211_BSS_FREQUENCY] = { .type = NLA_U32 },
-		[NL80211_BSS_STATUS]    = { .type = NLA_U32 },
-	};
+	if (attr[NL80211_ATTR_WIPHY])
+		phyidx = nla_get_u32(attr[NL80211_ATTR_WIPHY]);
 
-	if (attr[NL80211_ATTR_BSS] &&
-	    !nla_parse_nested(binfo, NL80211_BSS_MAX,
-	                      attr[NL80211_ATTR_BSS], bss_policy))
+	switch (gnlh->cmd)
 	{
-		if (binfo[NL80211_BSS_STATUS] && binfo[NL80211_BSS_FREQUENCY])
-			*freq = nla_get_u32(binfo[NL80211_BSS_FREQUENCY]);
+	case NL80211_CMD_NEW_WIPHY:
+	case NL80211_CMD_DEL_WIPHY:
+	case NL80211_CMD_WIPHY_REG_CHANGE:
+	case NL80211_CMD_REG_BEACON_HINT:
+		nl80211_wiphy_invalidate(phyidx);
+		break;
+
+	case NL80211_CMD_REG_CHANGE:
+		nl80211_wiphy_invalidate(-1);
+		break;
+
+	case NL80211_CMD_NEW_INTERFACE:
+	case NL80211_CMD_DEL_INTERFACE:
+	case NL80211_CMD_SET_INTERFACE:
+		nls->links_valid = false;
+		break;
 	}
 
 	return NL_SKIP;
 }
 
-static int nl80211_get_frequency_info_cb(struct nl_msg *msg, void *arg)
+/* Station notifications, only ever delivered from nl80211_dispatch() */
+static int nl80211_mlme_cb(struct nl_msg *msg, void *arg)
 {
-	int *freq = arg;
-	struct nlattr **tb = nl80211_parse(msg);
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
 
-	if (tb[NL80211_ATTR_WIPHY_FREQ])
-		*freq = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ]);
+	nl80211_sta_watch_event(gnlh->cmd, nl80211_parse(msg));
 
 	return NL_SKIP;
 }
 
-static int nl80211_get_frequency(const char *ifname, int *buf)
+/*
+ * Link notifications only matter for interfaces in the resolver cache, a
+ * rename or removal of one of those makes the cache stale.
+ */
+static int nl80211_route_cb(struct nl_msg *msg, void *arg)
 {
-	char *res, channel[4], hwmode[2];
+	struct nlmsghdr *hdr = nlmsg_hdr(msg);
+	struct ifinfomsg *ifi = nlmsg_data(hdr);
+	struct nlattr *tb[IFLA_MAX + 1];
+	struct nl80211_link *l;
 
-	/* try to find frequency from interface info */
-	res = nl80211_phy2ifname(ifname);
-	*buf = 0;
+	if (hdr->nlmsg_type != RTM_NEWLINK && hdr->nlmsg_type != RTM_DELLINK)
+		return NL_SKIP;
 
-	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
-	                nl80211_get_frequency_info_cb, buf);
+	if (nlmsg_parse(hdr, sizeof(*ifi), tb, IFLA_MAX, NULL))
+		return NL_SKIP;
 
-	/* failed, try to find frequency from hostapd info */
-	if ((*buf == 0) &&
-	    nl80211_hostapd_query(ifname, "hw_mode", hwmode, sizeof(hwmode),
-	                                  "channel", channel, sizeof(channel)) == 2)
+	for (l = nls->links; l; l = l->next)
 	{
-		*buf = nl80211_channel2freq(atoi(channel), hwmode);
+		if (l->ifindex == ifi->ifi_index ||
+		    (tb[IFLA_IFNAME] && !strcmp(l->ifname, nla_get_string(tb[IFLA_IFNAME]))))
+		{
+			nls->links_valid = false;
+			return NL_SKIP;
+		}
 	}
 
-	/* failed, try to find frequency from scan results */
-	if (*buf == 0)
-	{
-		res = nl80211_phy2ifname(ifname);
-
-		nl80211_request(res ? res : ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
-		                nl80211_get_frequency_scan_cb, buf);
-	}
+	/* an unknown netdev showing up might be a new wireless interface */
+	if (hdr->nlmsg_type == RTM_NEWLINK)
+		nls->links_valid = false;
 
-	return (*buf == 0) ? -1 : 0;
+	return NL_SKIP;
 }
 
-static int nl80211_get_channel(const char *ifname, int *buf)
+static void nl80211_route_init(void)
 {
-	if (!nl80211_get_frequency(ifname, buf))
-	{
-		*buf = nl80211_freq2channel(*buf);
-		return 0;
-	}
+	int fd;
 
-	return -1;
-}
+	nls->nl_route = nl_socket_alloc();
+	nls->nl_route_cb = nl_cb_alloc(NL_CB_DEFAULT);
 
-static int nl80211_get_txpower_cb(struct nl_msg *msg, void *arg)
-{
-	int *buf = arg;
-	struct nlattr **tb = nl80211_parse(msg);
+	if (!nls->nl_route || !nls->nl_route_cb)
+		goto err;
 
-	if (tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL])
-		*buf = lwf_mbm2dbm(nla_get_u32(tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL]));
+	nl_socket_disable_seq_check(nls->nl_route);
 
-	return NL_SKIP;
-}
+	if (nl_connect(nls->nl_route, NETLINK_ROUTE) ||
+	    nl_socket_add_membership(nls->nl_route, RTNLGRP_LINK))
+		goto err;
 
-static int nl80211_get_txpower(const char *ifname, int *buf)
-{
-	char *res;
+	fd = nl_socket_get_fd(nls->nl_route);
+	if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+	    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+		goto err;
 
-	res = nl80211_phy2ifname(ifname);
-	*buf = 0;
+	nl_socket_set_buffer_size(nls->nl_route, NL80211_EVENT_RCVBUF, 0);
 
-	if (nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
-	                    nl80211_get_txpower_cb, buf))
-		return -1;
+	nl_cb_set(nls->nl_route_cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM,
+	          nl80211_wait_seq_check, NULL);
+	nl_cb_set(nls->nl_route_cb, NL_CB_VALID, NL_CB_CUSTOM,
+	          nl80211_route_cb, NULL);
 
-	return 0;
-}
+	return;
+
+err:
+	if (nls->nl_route_cb)
+		nl_cb_put(nls->nl_route_cb);
 
+	if (nls->nl_route)
+		nl_socket_free(nls->nl_route);
 
-static int nl80211_fill_signal_cb(struct nl_msg *msg, void *arg)
+	nls->nl_route_cb = NULL;
+	nls->nl_route = NULL;
+}
+
+static int nl80211_events_init(void)
 {
-	int8_t dbm;
-	int16_t mbit;
-	struct nl80211_rssi_rate *rr = arg;
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
-	struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
+	const char *groups[] = { "config", "regulatory" };
+	int i, id, fd;
 
-	static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1] = {
-		[NL80211_STA_INFO_INACTIVE_TIME] = { .type = NLA_U32    },
-		[NL80211_STA_INFO_RX_BYTES]      = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_BYTES]      = { .type = NLA_U32    },
-		[NL80211_STA_INFO_RX_PACKETS]    = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_PACKETS]    = { .type = NLA_U32    },
-		[NL80211_STA_INFO_SIGNAL]        = { .type = NLA_U8     },
-		[NL80211_STA_INFO_TX_BITRATE]    = { .type = NLA_NESTED },
-		[NL80211_STA_INFO_LLID]          = { .type = NLA_U16    },
-		[NL80211_STA_INFO_PLID]          = { .type = NLA_U16    },
-		[NL80211_STA_INFO_PLINK_STATE]   = { .type = NLA_U8     },
-	};
+	if (nls->nl_event)
+		return 0;
 
-	static struct nla_policy rate_policy[NL80211_RATE_INFO_MAX + 1] = {
-		[NL80211_RATE_INFO_BITRATE]      = { .type = NLA_U16  },
-		[NL80211_RATE_INFO_MCS]          = { .type = NLA_U8   },
-		[NL80211_RATE_INFO_40_MHZ_WIDTH] = { .type = NLA_FLAG },
-		[NL80211_RATE_INFO_SHORT_GI]     = { .type = NLA_FLAG },
-	};
+	nls->nl_event = nl_socket_alloc();
+	nls->nl_event_cb = nl_cb_alloc(NL_CB_DEFAULT);
+
+	if (!nls->nl_event || !nls->nl_event_cb)
+		goto err;
+
+	if (genl_connect(nls->nl_event))
+		goto err;
+
+	fd = nl_socket_get_fd(nls->nl_event);
+	if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+	    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+		goto err;
+
+	nl_socket_set_buffer_size(nls->nl_event, NL80211_EVENT_RCVBUF, 0);
 
-	if (attr[NL80211_ATTR_STA_INFO])
+	for (i = 0; i < ARRAY_SIZE(groups); i++)
 	{
-		if (!nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
-		                      attr[NL80211_ATTR_STA_INFO], stats_policy))
-		{
-			if (sinfo[NL80211_STA_INFO_SIGNAL])
-			{
-				dbm = nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]);
-				rr->rssi = (rr->rssi * rr->rssi_samples + dbm) / (rr->rssi_samples + 1);
-				rr->rssi_samples++;
-			}
+		id = nl80211_get_group("nl80211", groups[i]);
 
-			if (sinfo[NL80211_STA_INFO_TX_BITRATE])
-			{
-				if (!nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX,
-				                      sinfo[NL80211_STA_INFO_TX_BITRATE],
-				                      rate_policy))
-				{
-					if (rinfo[NL80211_RATE_INFO_BITRATE])
-					{
-						mbit = nla_get_u16(rinfo[NL80211_RATE_INFO_BITRATE]);
-						rr->rate = (rr->rate * rr->rate_samples + mbit) / (rr->rate_samples + 1);
-						rr->rate_samples++;
-					}
-				}
-			}
-		}
+		if (id < 0 || nl_socket_add_membership(nls->nl_event, id))
+			goto err;
 	}
 
-	return NL_SKIP;
-}
+	nl_cb_set(nls->nl_event_cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM,
+	          nl80211_wait_seq_check, NULL);
+	nl_cb_set(nls->nl_event_cb, NL_CB_VALID, NL_CB_CUSTOM,
+	          nl80211_events_cb, NULL);
 
-static void nl80211_fill_signal(const char *ifname, struct nl80211_rssi_rate *r)
-{
-	DIR *d;
-	struct dirent *de;
+	/* without link events the resolver cache is simply not used */
+	nl80211_route_init();
 
-	memset(r, 0, sizeof(*r));
+	return 0;
 
-	if ((d = opendir("/sys/class/net")) != NULL)
-	{
-		while ((de = readdir(d)) != NULL)
+err:
+	if (nls->nl_event_cb)
+		nl_cb_put(nls->nl_event_cb);
+
+	if (nls->nl_event)
+		nl_socket_free(nls->nl_event);
+
+	nls->nl_event_cb = NULL;
+	nls->nl_event = NULL;
+
+	return -ENOLINK;
+}
+
+/*
+ * Drain pending multicast notifications without blocking and drop any cached
+ * state they affect. Without an event socket nothing can be trusted, so all
+ * caches are flushed. This never calls back into the user, station events
+ * arrive on their own socket, see nl80211_mlme_process().
+ */
+static void nl80211_events_process(void)
+{
+	struct pollfd pfd[2] = {
+		{ .events = POLLIN },
+		{ .events = POLLIN, .fd = -1 }
+	};
+	int err;
+
+	if (nl80211_events_init())
+	{
+		nl80211_wiphy_invalidate(-1);
+		return;
+	}
+
+	pfd[0].fd = nl_socket_get_fd(nls->nl_event);
+
+	if (nls->nl_route)
+		pfd[1].fd = nl_socket_get_fd(nls->nl_route);
+
+	/* both sockets are checked with a single poll() */
+	while (poll(pfd, 2, 0) > 0)
+	{
+		if (pfd[0].revents)
 		{
-			if (!strncmp(de->d_name, ifname, strlen(ifname)) &&
-			    (!de->d_name[strlen(ifname)] ||
-			     !strncmp(&de->d_name[strlen(ifname)], ".sta", 4)))
+			err = nl_recvmsgs(nls->nl_event, nls->nl_event_cb);
+
+			/* receive buffer overrun, events were lost */
+			if (err < 0 && err != -NLE_AGAIN)
 			{
-				nl80211_request(de->d_name, NL80211_CMD_GET_STATION,
-				                NLM_F_DUMP, nl80211_fill_signal_cb, r);
+				nl80211_wiphy_invalidate(-1);
+				nls->links_valid = false;
+				break;
 			}
 		}
 
-		closedir(d);
+		if (pfd[1].revents)
+		{
+			err = nl_recvmsgs(nls->nl_route, nls->nl_route_cb);
+
+			if (err < 0 && err != -NLE_AGAIN)
+			{
+				nls->links_valid = false;
+				break;
+			}
+		}
 	}
 }
 
-static int nl80211_get_bitrate(const char *ifname, int *buf)
+/*
+ * Link notifications only, for the resolver which runs in the middle of
+ * arbitrary requests and must not consume nl80211 events on their behalf.
+ */
+static void nl80211_route_process(void)
 {
-	struct nl80211_rssi_rate rr;
+	struct pollfd pfd = { .events = POLLIN };
+	int err;
+
+	if (!nls->nl_route)
+		return;
 
-	nl80211_fill_signal(ifname, &rr);
+	pfd.fd = nl_socket_get_fd(nls->nl_route);
 
-	if (rr.rate_samples)
+	while (poll(&pfd, 1, 0) > 0)
 	{
-		*buf = (rr.rate * 100);
-		return 0;
-	}
+		err = nl_recvmsgs(nls->nl_route, nls->nl_route_cb);
 
-	return -1;
+		if (err < 0 && err != -NLE_AGAIN)
+		{
+			nls->links_valid = false;
+			break;
+		}
+	}
 }
 
-static int nl80211_get_signal(const char *ifname, int *buf)
+static void nl80211_links_free(void)
 {
-	struct nl80211_rssi_rate rr;
-
-	nl80211_fill_signal(ifname, &rr);
+	struct nl80211_link *l;
 
-	if (rr.rssi_samples)
+	while ((l = nls->links) != NULL)
 	{
-		*buf = rr.rssi;
-		return 0;
+		nls->links = l->next;
+		free(l);
 	}
 
-	return -1;
+	nls->links_valid = false;
 }
 
-static int nl80211_get_noise_cb(struct nl_msg *msg, void *arg)
+static int nl80211_links_cb(struct nl_msg *msg, void *arg)
 {
-	int8_t *noise = arg;
 	struct nlattr **tb = nl80211_parse(msg);
-	struct nlattr *si[NL80211_SURVEY_INFO_MAX + 1];
-
-	static struct nla_policy sp[NL80211_SURVEY_INFO_MAX + 1] = {
-		[NL80211_SURVEY_INFO_FREQUENCY] = { .type = NLA_U32 },
-		[NL80211_SURVEY_INFO_NOISE]     = { .type = NLA_U8  },
-	};
+	struct nl80211_link *l;
 
-	if (!tb[NL80211_ATTR_SURVEY_INFO])
+	/* wdevs without netdev, like P2P devices, can not be addressed by name */
+	if (!tb[NL80211_ATTR_IFINDEX] || !tb[NL80211_ATTR_IFNAME] ||
+	    !tb[NL80211_ATTR_WIPHY])
 		return NL_SKIP;
 
-	if (nla_parse_nested(si, NL80211_SURVEY_INFO_MAX,
-	                     tb[NL80211_ATTR_SURVEY_INFO], sp))
+	if (!(l = calloc(1, sizeof(*l))))
 		return NL_SKIP;
 
-	if (!si[NL80211_SURVEY_INFO_NOISE])
-		return NL_SKIP;
+	strncpy(l->ifname, nla_get_string(tb[NL80211_ATTR_IFNAME]),
+	        sizeof(l->ifname) - 1);
 
-	if (!*noise || si[NL80211_SURVEY_INFO_IN_USE])
-		*noise = (int8_t)nla_get_u8(si[NL80211_SURVEY_INFO_NOISE]);
+	l->ifindex = nla_get_u32(tb[NL80211_ATTR_IFINDEX]);
+	l->phyidx = nla_get_u32(tb[NL80211_ATTR_WIPHY]);
+
+	if (tb[NL80211_ATTR_IFTYPE])
+		l->iftype = nla_get_u32(tb[NL80211_ATTR_IFTYPE]);
+
+	l->next = nls->links;
+	nls->links = l;
 
 	return NL_SKIP;
 }
 
-
-static int nl80211_get_noise(const char *ifname, int *buf)
+/*
+ * Wireless interfaces by name, filled by one GET_INTERFACE dump and kept
+ * until an nl80211 interface event or a link event touching one of the
+ * cached interfaces arrives. Returns -EAGAIN if no cache can be kept,
+ * the caller has to resolve the name the slow way then.
+ */
+static int nl80211_links_update(void)
 {
-	int8_t noise = 0;
+	struct nl80211_msg_conveyor *cv;
 
-	if (nl80211_request(ifname, NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
-	                    nl80211_get_noise_cb, &noise))
-		goto out;
+	if (nl80211_init() < 0 || nl80211_events_init())
+		return -EAGAIN;
 
-	*buf = noise;
-	return 0;
+	nl80211_route_process();
 
-out:
-	*buf = 0;
-	return -1;
+	if (!nls->nl_route)
+		return -EAGAIN;
+
+	if (nls->links_valid)
+		return 0;
+
+	nl80211_links_free();
+
+	cv = nl80211_new(nls->nl80211_id, NL80211_CMD_GET_INTERFACE, NLM_F_DUMP);
+
+	if (!cv || nl80211_send(cv, nl80211_links_cb, NULL))
+	{
+		nl80211_links_free();
+		return -EAGAIN;
+	}
+
+	nls->links_valid = true;
+	return 0;
 }
 
-static int nl80211_get_quality(const char *ifname, int *buf)
+static struct nl80211_link * nl80211_link_get(const char *ifname, int *err)
 {
-	int signal;
+	struct nl80211_link *l;
 
-	if (!nl80211_get_signal(ifname, &signal))
-	{
-		/* A positive signal level is usually just a quality
-		 * value, pass through as-is */
-		if (signal >= 0)
-		{
-			*buf = signal;
-		}
+	if ((*err = nl80211_links_update()) != 0)
+		return NULL;
 
-		/* The cfg80211 wext compat layer assumes a signal range
-		 * of -110 dBm to -40 dBm, the quality value is derived
-		 * by adding 110 to the signal level */
-		else
-		{
-			if (signal < -110)
-				signal = -110;
-			else if (signal > -40)
-				signal = -40;
+	for (l = nls->links; l; l = l->next)
+		if (!strcmp(l->ifname, ifname))
+			return l;
 
-			*buf = (signal + 110);
-		}
+	*err = -ENODEV;
+	return NULL;
+}
 
-		return 0;
-	}
+static int nl80211_ifindex(const char *ifname)
+{
+	struct nl80211_link *l;
+	int err;
 
-	return -1;
+	if ((l = nl80211_link_get(ifname, &err)) != NULL)
+		return l->ifindex;
+
+	/* not a wireless netdev or no cache, ask the kernel */
+	return if_nametoindex(ifname);
 }
 
-static int nl80211_get_quality_max(const char *ifname, int *buf)
+
+static int nl80211_phyidx(const char *ifname)
 {
-	/* The cfg80211 wext compat layer assumes a maximum
-	 * quality of 70 */
-	*buf = 70;
+	char path[64];
+	struct nl80211_link *l;
+	int err;
 
-	return 0;
+	if (!strncmp(ifname, "phy", 3))
+		return atoi(&ifname[3]);
+	else if (!strncmp(ifname, "mon.", 4))
+		ifname += 4;
+
+	if ((l = nl80211_link_get(ifname, &err)) != NULL)
+		return l->phyidx;
+	else if (err == -ENODEV)
+		return -1;
+
+	snprintf(path, sizeof(path), "/sys/class/net/%s/phy80211/index", ifname);
+
+	return nl80211_readint(path);
 }
 
-static int nl80211_check_wepkey(const char *key)
+static void nl80211_wiphy_add_freq(struct nl80211_wiphy_info *info,
+                                   int band, struct nlattr **freqs)
 {
-	if (key && *key)
+	struct nl80211_wiphy_freq *f;
+	int size;
+
+	if (!freqs[NL80211_FREQUENCY_ATTR_FREQ])
+		return;
+
+	if (info->freqs_count >= info->freqs_size)
 	{
-		switch (strlen(key))
-		{
-		case 5:
-		case 10:
-			return LWF_CIPHER_WEP40;
+		size = info->freqs_size ? info->freqs_size * 2 : 32;
+		f = realloc(info->freqs, size * sizeof(*f));
 
-		case 13:
-		case 26:
-			return LWF_CIPHER_WEP104;
-		}
+		if (!f)
+			return;
+
+		info->freqs = f;
+		info->freqs_size = size;
 	}
 
-	return 0;
+	f = &info->freqs[info->freqs_count++];
+	memset(f, 0, sizeof(*f));
+
+	f->band = band;
+	f->mhz = nla_get_u32(freqs[NL80211_FREQUENCY_ATTR_FREQ]);
+	f->max_txpower = -1;
+
+	if (freqs[NL80211_FREQUENCY_ATTR_MAX_TX_POWER])
+		f->max_txpower = (int)(0.01 * nla_get_u32(
+			freqs[NL80211_FREQUENCY_ATTR_MAX_TX_POWER]));
+
+	f->disabled = !!freqs[NL80211_FREQUENCY_ATTR_DISABLED];
+	f->restricted = (freqs[NL80211_FREQUENCY_ATTR_NO_IR] &&
+	                 !freqs[NL80211_FREQUENCY_ATTR_RADAR]) ? 1 : 0;
+
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_HT40_MINUS])
+		f->flags |= LWF_FREQ_NO_HT40MINUS;
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_HT40_PLUS])
+		f->flags |= LWF_FREQ_NO_HT40PLUS;
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_80MHZ])
+		f->flags |= LWF_FREQ_NO_80MHZ;
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_160MHZ])
+		f->flags |= LWF_FREQ_NO_160MHZ;
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_20MHZ])
+		f->flags |= LWF_FREQ_NO_20MHZ;
+	if (freqs[NL80211_FREQUENCY_ATTR_NO_10MHZ])
+		f->flags |= LWF_FREQ_NO_10MHZ;
 }
 
-static int nl80211_get_encryption(const char *ifname, char *buf)
+static void nl80211_wiphy_parse_ifcomb(struct nl80211_wiphy_info *info,
+                                       struct nlattr *combs)
 {
-	char wpa[2], wpa_key_mgmt[16], wpa_pairwise[16], wpa_groupwise[16];
-	char auth_algs[2], wep_key0[27], wep_key1[27], wep_key2[27], wep_key3[27];
+	struct nlattr *comb, *limit, *mode;
+	int comb_rem, limit_rem, mode_rem;
 
-	struct lwf_crypto_entry *c = (struct lwf_crypto_entry *)buf;
+	static struct nla_policy iface_combination_policy[NUM_NL80211_IFACE_COMB] = {
+		[NL80211_IFACE_COMB_LIMITS] = { .type = NLA_NESTED },
+		[NL80211_IFACE_COMB_MAXNUM] = { .type = NLA_U32 },
+	};
+	struct nlattr *tb_comb[NUM_NL80211_IFACE_COMB+1];
+	static struct nla_policy iface_limit_policy[NUM_NL80211_IFACE_LIMIT] = {
+		[NL80211_IFACE_LIMIT_TYPES] = { .type = NLA_NESTED },
+		[NL80211_IFACE_LIMIT_MAX] = { .type = NLA_U32 },
+	};
+	struct nlattr *tb_limit[NUM_NL80211_IFACE_LIMIT+1];
 
-	/* WPA supplicant */
-	if (nl80211_wpactl_query(ifname,
-			"pairwise_cipher", wpa_pairwise,  sizeof(wpa_pairwise),
-			"group_cipher",    wpa_groupwise, sizeof(wpa_groupwise),
-			"key_mgmt",        wpa_key_mgmt,  sizeof(wpa_key_mgmt)))
+	info->mbssid = 0;
+
+	nla_for_each_nested(comb, combs, comb_rem)
 	{
-		/* WEP */
-		if (!strcmp(wpa_key_mgmt, "NONE"))
+		nla_parse_nested(tb_comb, NUM_NL80211_IFACE_COMB, comb, iface_combination_policy);
+
+		if (!tb_comb[NL80211_IFACE_COMB_LIMITS])
+			continue;
+
+		nla_for_each_nested(limit, tb_comb[NL80211_IFACE_COMB_LIMITS], limit_rem)
 		{
-			if (strstr(wpa_pairwise, "WEP-40"))
-				c->pair_ciphers |= LWF_CIPHER_WEP40;
-			else if (strstr(wpa_pairwise, "WEP-104"))
-				c->pair_ciphers |= LWF_CIPHER_WEP104;
+			nla_parse_nested(tb_limit, NUM_NL80211_IFACE_LIMIT, limit, iface_limit_policy);
 
-			if (strstr(wpa_groupwise, "WEP-40"))
-				c->group_ciphers |= LWF_CIPHER_WEP40;
-			else if (strstr(wpa_groupwise, "WEP-104"))
-				c->group_ciphers |= LWF_CIPHER_WEP104;
+			if (!tb_limit[NL80211_IFACE_LIMIT_TYPES] ||
+			    !tb_limit[NL80211_IFACE_LIMIT_MAX])
+				continue;
 
-			c->enabled      = !!(c->pair_ciphers | c->group_ciphers);
-			c->auth_suites |= LWF_KMGMT_NONE;
-			c->auth_algs   |= LWF_AUTH_OPEN; /* XXX: assumption */
+			if (nla_get_u32(tb_limit[NL80211_IFACE_LIMIT_MAX]) < 2)
+				continue;
+
+			nla_for_each_nested(mode, tb_limit[NL80211_IFACE_LIMIT_TYPES], mode_rem) {
+				if (nla_type(mode) == NL80211_IFTYPE_AP)
+					info->mbssid = 1;
+			}
 		}
+	}
+}
 
-		/* WPA */
-		else if (strstr(wpa_key_mgmt, "WPA"))
-		{
-			if (strstr(wpa_pairwise, "TKIP"))
-				c->pair_ciphers |= LWF_CIPHER_TKIP;
-			else if (strstr(wpa_pairwise, "CCMP"))
-				c->pair_ciphers |= LWF_CIPHER_CCMP;
-			else if (strstr(wpa_pairwise, "NONE"))
-				c->pair_ciphers |= LWF_CIPHER_NONE;
-			else if (strstr(wpa_pairwise, "WEP-40"))
-				c->pair_ciphers |= LWF_CIPHER_WEP40;
-			else if (strstr(wpa_pairwise, "WEP-104"))
-				c->pair_ciphers |= LWF_CIPHER_WEP104;
+/*
+ * With split dumps a single wiphy is spread over several messages and the
+ * frequencies of one band may be spread over more than one of them, so this
+ * only accumulates raw data; the mode masks are derived once the dump is done.
+ */
+static int nl80211_wiphy_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_wiphy_info *info = arg;
+	int bands_remain, freqs_remain, idx;
 
-			if (strstr(wpa_groupwise, "TKIP"))
-				c->group_ciphers |= LWF_CIPHER_TKIP;
-			else if (strstr(wpa_groupwise, "CCMP"))
-				c->group_ciphers |= LWF_CIPHER_CCMP;
-			else if (strstr(wpa_groupwise, "NONE"))
-				c->group_ciphers |= LWF_CIPHER_NONE;
-			else if (strstr(wpa_groupwise, "WEP-40"))
-				c->group_ciphers |= LWF_CIPHER_WEP40;
-			else if (strstr(wpa_groupwise, "WEP-104"))
-				c->group_ciphers |= LWF_CIPHER_WEP104;
+	struct nlattr **attr = nl80211_parse(msg);
+	struct nlattr *bands[NL80211_BAND_ATTR_MAX + 1];
+	struct nlattr *freqs[NL80211_FREQUENCY_ATTR_MAX + 1];
+	struct nlattr *band, *freq;
 
-			if (strstr(wpa_key_mgmt, "WPA2"))
-				c->wpa_version = 2;
-			else if (strstr(wpa_key_mgmt, "WPA"))
-				c->wpa_version = 1;
+	static struct nla_policy freq_policy[NL80211_FREQUENCY_ATTR_MAX + 1] = {
+		[NL80211_FREQUENCY_ATTR_FREQ]         = { .type = NLA_U32  },
+		[NL80211_FREQUENCY_ATTR_DISABLED]     = { .type = NLA_FLAG },
+		[NL80211_FREQUENCY_ATTR_NO_IR]        = { .type = NLA_FLAG },
+		[NL80211_FREQUENCY_ATTR_RADAR]        = { .type = NLA_FLAG },
+		[NL80211_FREQUENCY_ATTR_MAX_TX_POWER] = { .type = NLA_U32  },
+	};
 
-			if (strstr(wpa_key_mgmt, "PSK"))
-				c->auth_suites |= LWF_KMGMT_PSK;
-			else if (strstr(wpa_key_mgmt, "EAP") ||
-			         strstr(wpa_key_mgmt, "802.1X"))
-				c->auth_suites |= LWF_KMGMT_8021x;
-			else if (strstr(wpa_key_mgmt, "NONE"))
-				c->auth_suites |= LWF_KMGMT_NONE;
+	if (attr[NL80211_ATTR_WIPHY_NAME])
+		snprintf(info->name, sizeof(info->name), "%s",
+		         nla_get_string(attr[NL80211_ATTR_WIPHY_NAME]));
 
-			c->enabled = !!(c->wpa_version && c->auth_suites);
-		}
+	if (attr[NL80211_ATTR_INTERFACE_COMBINATIONS])
+		nl80211_wiphy_parse_ifcomb(info,
+			attr[NL80211_ATTR_INTERFACE_COMBINATIONS]);
 
-		return 0;
-	}
+	if (attr[NL80211_ATTR_FEATURE_FLAGS])
+		info->feature_flags = nla_get_u32(attr[NL80211_ATTR_FEATURE_FLAGS]);
 
-	/* Hostapd */
-	else if (nl80211_hostapd_query(ifname,
-				"wpa",          wpa,          sizeof(wpa),
-				"wpa_key_mgmt", wpa_key_mgmt, sizeof(wpa_key_mgmt),
-				"wpa_pairwise", wpa_pairwise, sizeof(wpa_pairwise),
-				"auth_algs",    auth_algs,    sizeof(auth_algs),
-				"wep_key0",     wep_key0,     sizeof(wep_key0),
-				"wep_key1",     wep_key1,     sizeof(wep_key1),
-				"wep_key2",     wep_key2,     sizeof(wep_key2),
-				"wep_key3",     wep_key3,     sizeof(wep_key3)))
+	if (!attr[NL80211_ATTR_WIPHY_BANDS])
+		return NL_SKIP;
+
+	info->ok = true;
+
+	nla_for_each_nested(band, attr[NL80211_ATTR_WIPHY_BANDS], bands_remain)
 	{
-		c->wpa_version = wpa[0] ? atoi(wpa) : 0;
+		idx = nla_type(band);
 
-		if (wpa_key_mgmt[0])
-		{
-			if (strstr(wpa_key_mgmt, "PSK"))
-				c->auth_suites |= LWF_KMGMT_PSK;
+		if (idx >= NL80211_WIPHY_BANDS)
+			continue;
 
-			if (strstr(wpa_key_mgmt, "EAP"))
-				c->auth_suites |= LWF_KMGMT_8021x;
+		nla_parse(bands, NL80211_BAND_ATTR_MAX, nla_data(band),
+		          nla_len(band), NULL);
 
-			if (strstr(wpa_key_mgmt, "NONE"))
-				c->auth_suites |= LWF_KMGMT_NONE;
+		info->bands[idx].present = 1;
+
+		if (bands[NL80211_BAND_ATTR_HT_CAPA])
+			info->bands[idx].ht_caps =
+				nla_get_u16(bands[NL80211_BAND_ATTR_HT_CAPA]);
+
+		if (bands[NL80211_BAND_ATTR_VHT_CAPA])
+		{
+			info->bands[idx].has_vht = 1;
+			info->bands[idx].vht_caps =
+				nla_get_u32(bands[NL80211_BAND_ATTR_VHT_CAPA]);
 		}
-		else
+
+		if (!bands[NL80211_BAND_ATTR_FREQS])
+			continue;
+
+		nla_for_each_nested(freq, bands[NL80211_BAND_ATTR_FREQS], freqs_remain)
 		{
-			c->auth_suites |= LWF_KMGMT_PSK;
+			nla_parse(freqs, NL80211_FREQUENCY_ATTR_MAX,
+			          nla_data(freq), nla_len(freq), freq_policy);
+
+			nl80211_wiphy_add_freq(info, idx, freqs);
 		}
+	}
 
-		if (wpa_pairwise[0])
+	return NL_SKIP;
+}
+
+static void nl80211_wiphy_modes(struct nl80211_wiphy_info *info)
+{
+	struct nl80211_wiphy_band *b;
+	int i, idx;
+
+	for (idx = 0; idx < NL80211_WIPHY_BANDS; idx++)
+	{
+		b = &info->bands[idx];
+
+		if (!b->present)
+			continue;
+
+		/* Treat any nonzero capability as 11n */
+		if (b->ht_caps > 0)
 		{
-			if (strstr(wpa_pairwise, "TKIP"))
-				c->pair_ciphers |= LWF_CIPHER_TKIP;
+			info->hwmodes |= LWF_80211_N;
+			info->htmodes |= LWF_HTMODE_HT20;
 
-			if (strstr(wpa_pairwise, "CCMP"))
-				c->pair_ciphers |= LWF_CIPHER_CCMP;
+			if (b->ht_caps & (1 << 1))
+				info->htmodes |= LWF_HTMODE_HT40;
+		}
 
-			if (strstr(wpa_pairwise, "NONE"))
-				c->pair_ciphers |= LWF_CIPHER_NONE;
+		for (i = 0; i < info->freqs_count; i++)
+		{
+			if (info->freqs[i].band != idx)
+				continue;
+
+			if (info->freqs[i].mhz < 2485)
+			{
+				info->hwmodes |= LWF_80211_B;
+				info->hwmodes |= LWF_80211_G;
+			}
+			else if (b->has_vht)
+			{
+				/* Treat any nonzero capability as 11ac */
+				if (b->vht_caps > 0)
+				{
+					info->hwmodes |= LWF_80211_AC;
+					info->htmodes |= LWF_HTMODE_VHT20 | LWF_HTMODE_VHT40 | LWF_HTMODE_VHT80;
+
+					switch ((b->vht_caps >> 2) & 3)
+					{
+					case 2:
+						info->htmodes |= LWF_HTMODE_VHT80_80;
+						/* fall through */
+
+					case 1:
+						info->htmodes |= LWF_HTMODE_VHT160;
+					}
+				}
+			}
+			else if (!(info->hwmodes & LWF_80211_AC))
+			{
+				info->hwmodes |= LWF_80211_A;
+			}
 		}
+	}
+}
 
-		if (auth_algs[0])
+/*
+ * Return the capabilities of the wiphy behind ifname, fetching them with a
+ * single (split, if supported) GET_WIPHY dump on a cache miss. Entries are
+ * kept until a wiphy or regulatory notification invalidates them.
+ */
+static struct nl80211_wiphy_info * nl80211_wiphy_get(const char *ifname)
+{
+	struct nl80211_msg_conveyor *cv;
+	struct nl80211_wiphy_info *info;
+	uint32_t features;
+	int phyidx, flags;
+
+	if (ifname == NULL || nl80211_init() < 0)
+		return NULL;
+
+	nl80211_events_process();
+
+	phyidx = nl80211_phyidx(ifname);
+
+	for (info = nls->wiphy; phyidx >= 0 && info; info = info->next)
+		if (info->phyidx == phyidx)
+			return info;
+
+	info = calloc(1, sizeof(*info));
+	if (!info)
+		return NULL;
+
+	info->phyidx = phyidx;
+
+	features = nl80211_get_protocol_features(ifname);
+	flags = features & NL80211_PROTOCOL_FEATURE_SPLIT_WIPHY_DUMP ? NLM_F_DUMP : 0;
+	cv = nl80211_msg(ifname, NL80211_CMD_GET_WIPHY, flags);
+	if (!cv)
+		goto err;
+
+	NLA_PUT_FLAG(cv->msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+	if (nl80211_send(cv, nl80211_wiphy_cb, info) || !info->ok)
+		goto err;
+
+	nl80211_wiphy_modes(info);
+
+	/* no usable phy index, keep the result only until the next lookup */
+	if (phyidx < 0)
+	{
+		nl80211_wiphy_free(nls->wiphy_tmp);
+		nls->wiphy_tmp = info;
+	}
+	else
+	{
+		info->next = nls->wiphy;
+		nls->wiphy = info;
+	}
+
+	return info;
+
+nla_put_failure:
+	nl80211_free(cv);
+err:
+	nl80211_wiphy_free(info);
+	return NULL;
+}
+
+
+static int nl80211_freq2channel(int freq)
+{
+	if (freq == 2484)
+		return 14;
+	else if (freq < 2484)
+		return (freq - 2407) / 5;
+	else if (freq >= 4910 && freq <= 4980)
+		return (freq - 4000) / 5;
+	else
+		return (freq - 5000) / 5;
+}
+
+static int nl80211_channel2freq(int channel, const char *band)
+{
+	if (!band || band[0] != 'a')
+	{
+		if (channel == 14)
+			return 2484;
+		else if (channel < 14)
+			return (channel * 5) + 2407;
+	}
+	else
+	{
+		if (channel >= 182 && channel <= 196)
+			return (channel * 5) + 4000;
+		else
+			return (channel * 5) + 5000;
+	}
+
+	return 0;
+}
+
+static int nl80211_ifname2phy_cb(struct nl_msg *msg, void *arg)
+{
+	char *buf = arg;
+	struct nlattr **attr = nl80211_parse(msg);
+
+	if (attr[NL80211_ATTR_WIPHY_NAME])
+		memcpy(buf, nla_data(attr[NL80211_ATTR_WIPHY_NAME]),
+		       nla_len(attr[NL80211_ATTR_WIPHY_NAME]));
+	else
+		buf[0] = 0;
+
+	return NL_SKIP;
+}
+
+static char * nl80211_ifname2phy(const char *ifname)
+{
+	static __thread char phy[32] = { 0 };
+	struct nl80211_link *l;
+	char path[64];
+	int err;
+
+	if ((l = nl80211_link_get(ifname, &err)) != NULL)
+	{
+		if (!l->phyname[0])
 		{
-			switch(atoi(auth_algs))
+			snprintf(path, sizeof(path), "/sys/class/net/%s/phy80211/name",
+			         l->ifname);
+
+			if (nl80211_readstr(path, l->phyname, sizeof(l->phyname)) <= 0)
+				l->phyname[0] = 0;
+		}
+
+		if (l->phyname[0])
+			return l->phyname;
+	}
+	else if (err == -ENODEV && strncmp(ifname, "phy", 3) &&
+	         strncmp(ifname, "mon.", 4))
+	{
+		return NULL;
+	}
+
+	memset(phy, 0, sizeof(phy));
+
+	nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
+	                nl80211_ifname2phy_cb, phy);
+
+	return phy[0] ? phy : NULL;
+}
+
+static char * nl80211_phy2ifname(const char *ifname)
+{
+	int ifidx = -1, cifidx = -1, phyidx = -1;
+	char buffer[64];
+	static __thread char nif[IFNAMSIZ] = { 0 };
+	struct nl80211_link *l;
+
+	DIR *d;
+	struct dirent *e;
+
+	/* Only accept phy name of the form phy%d */
+	if (!ifname)
+		return NULL;
+	else if (!strncmp(ifname, "phy", 3))
+		phyidx = atoi(&ifname[3]);
+	else
+		return NULL;
+
+	memset(nif, 0, sizeof(nif));
+
+	/* pick the interface with the lowest index, like the sysfs scan */
+	if (phyidx > -1 && !nl80211_links_update())
+	{
+		for (l = nls->links; l; l = l->next)
+		{
+			if (l->phyidx == phyidx && ((ifidx < 0) || (l->ifindex < ifidx)))
 			{
-			case 1:
-				c->auth_algs |= LWF_AUTH_OPEN;
-				break;
+				ifidx = l->ifindex;
+				memcpy(nif, l->ifname, sizeof(nif));
+			}
+		}
+	}
+	else if (phyidx > -1)
+	{
+		if ((d = opendir("/sys/class/net")) != NULL)
+		{
+			while ((e = readdir(d)) != NULL)
+			{
+				snprintf(buffer, sizeof(buffer),
+				         "/sys/class/net/%s/phy80211/index", e->d_name);
+
+				if (nl80211_readint(buffer) == phyidx)
+				{
+					snprintf(buffer, sizeof(buffer),
+					         "/sys/class/net/%s/ifindex", e->d_name);
+
+					if ((cifidx = nl80211_readint(buffer)) >= 0 &&
+					    ((ifidx < 0) || (cifidx < ifidx)))
+					{
+						ifidx = cifidx;
+						strncpy(nif, e->d_name, sizeof(nif) - 1);
+					}
+				}
+			}
+
+			closedir(d);
+		}
+	}
+
+	return nif[0] ? nif : NULL;
+}
+
+static int nl80211_iftype2mode(uint32_t iftype)
+{
+	const int ifmodes[NL80211_IFTYPE_MAX + 1] = {
+		LWF_OPMODE_UNKNOWN,		/* unspecified */
+		LWF_OPMODE_ADHOC,		/* IBSS */
+		LWF_OPMODE_CLIENT,		/* managed */
+		LWF_OPMODE_MASTER,		/* AP */
+		LWF_OPMODE_AP_VLAN,		/* AP/VLAN */
+		LWF_OPMODE_WDS,			/* WDS */
+		LWF_OPMODE_MONITOR,		/* monitor */
+		LWF_OPMODE_MESHPOINT,	/* mesh point */
+		LWF_OPMODE_P2P_CLIENT,	/* P2P-client */
+		LWF_OPMODE_P2P_GO,		/* P2P-GO */
+	};
+
+	if (iftype > NL80211_IFTYPE_MAX)
+		return LWF_OPMODE_UNKNOWN;
+
+	return ifmodes[iftype];
+}
+
+static int nl80211_get_mode_cb(struct nl_msg *msg, void *arg)
+{
+	int *mode = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+
+	if (tb[NL80211_ATTR_IFTYPE])
+		*mode = nl80211_iftype2mode(nla_get_u32(tb[NL80211_ATTR_IFTYPE]));
+
+	return NL_SKIP;
+}
+
+
+static int nl80211_get_mode(const char *ifname, int *buf)
+{
+	struct nl80211_link *l;
+	char *res;
+	int err;
+
+	*buf = LWF_OPMODE_UNKNOWN;
+
+	res = nl80211_phy2ifname(ifname);
+
+	if ((l = nl80211_link_get(res ? res : ifname, &err)) != NULL)
+	{
+		*buf = nl80211_iftype2mode(l->iftype);
+		return (*buf == LWF_OPMODE_UNKNOWN) ? -1 : 0;
+	}
+
+	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
+	                nl80211_get_mode_cb, buf);
+
+	return (*buf == LWF_OPMODE_UNKNOWN) ? -1 : 0;
+}
+
+static int __nl80211_hostapd_query(const char *ifname, ...)
+{
+	va_list ap, ap_cur;
+	char *phy, *search, *dest, *key, *val, buf[128];
+	int len, mode, found = 0, match = 1;
+	FILE *fp;
+
+	if (nl80211_get_mode(ifname, &mode))
+		return 0;
+
+	if (mode != LWF_OPMODE_MASTER && mode != LWF_OPMODE_AP_VLAN)
+		return 0;
+
+	phy = nl80211_ifname2phy(ifname);
+
+	if (!phy)
+		return 0;
+
+	snprintf(buf, sizeof(buf), "/var/run/hostapd-%s.conf", phy);
+	fp = fopen(buf, "r");
+
+	if (!fp)
+		return 0;
+
+	va_start(ap, ifname);
+
+	/* clear all destination buffers */
+	va_copy(ap_cur, ap);
+
+	while ((search = va_arg(ap_cur, char *)) != NULL)
+	{
+		dest = va_arg(ap_cur, char *);
+		len  = va_arg(ap_cur, int);
+
+		memset(dest, 0, len);
+	}
+
+	va_end(ap_cur);
+
+	/* iterate applicable lines and copy found values into dest buffers */
+	while (fgets(buf, sizeof(buf), fp))
+	{
+		key = strtok(buf, " =\t\n");
+		val = strtok(NULL, "\n");
+
+		if (!key || !val || !*key || *key == '#')
+			continue;
+
+		if (!strcmp(key, "interface") || !strcmp(key, "bss"))
+			match = !strcmp(ifname, val);
+
+		if (!match)
+			continue;
+
+		va_copy(ap_cur, ap);
+
+		while ((search = va_arg(ap_cur, char *)) != NULL)
+		{
+			dest = va_arg(ap_cur, char *);
+			len  = va_arg(ap_cur, int);
+
+			if (!strcmp(search, key))
+			{
+				strncpy(dest, val, len - 1);
+				found++;
+				break;
+			}
+		}
+
+		va_end(ap_cur);
+	}
+
+	fclose(fp);
+
+	va_end(ap);
+
+	return found;
+}
+
+#define nl80211_hostapd_query(ifname, ...) \
+	__nl80211_hostapd_query(ifname, ##__VA_ARGS__, NULL)
+
+
+static inline int nl80211_wpactl_recv(int sock, char *buf, int blen)
+{
+	fd_set rfds;
+	struct timeval tv = { 0, 256000 };
+
+	FD_ZERO(&rfds);
+	FD_SET(sock, &rfds);
+
+	memset(buf, 0, blen);
+
+	if (select(sock + 1, &rfds, NULL, NULL, &tv) < 0)
+		return -1;
+
+	if (!FD_ISSET(sock, &rfds))
+		return -1;
+
+	return recv(sock, buf, blen - 1, 0);
+}
+
+static int nl80211_wpactl_connect(const char *ifname, struct sockaddr_un *local)
+{
+	struct sockaddr_un remote = { 0 };
+	size_t remote_length, local_length;
+
+	int sock = socket(PF_UNIX, SOCK_DGRAM, 0);
+	if (sock < 0)
+		return sock;
+
+	remote.sun_family = AF_UNIX;
+	remote_length = sizeof(remote.sun_family) +
+		sprintf(remote.sun_path, "/var/run/wpa_supplicant-%s/%s",
+		        ifname, ifname);
+
+	if (fcntl(sock, F_SETFD, fcntl(sock, F_GETFD) | FD_CLOEXEC) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	if (connect(sock, (struct sockaddr *)&remote, remote_length))
+	{
+		remote_length = sizeof(remote.sun_family) +
+			sprintf(remote.sun_path, "/var/run/wpa_supplicant/%s", ifname);
+
+		if (connect(sock, (struct sockaddr *)&remote, remote_length))
+		{
+			close(sock);
+			return -1;
+		}
+	}
+
+	local->sun_family = AF_UNIX;
+	local_length = sizeof(local->sun_family) +
+		sprintf(local->sun_path, "/var/run/lwf-%s-%d", ifname, getpid());
+
+	if (bind(sock, (struct sockaddr *)local, local_length) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static int __nl80211_wpactl_query(const char *ifname, ...)
+{
+	va_list ap, ap_cur;
+	struct sockaddr_un local = { 0 };
+	int len, mode, found = 0, sock = -1;
+	char *search, *dest, *key, *val, *line, *pos, buf[512];
+
+	if (nl80211_get_mode(ifname, &mode))
+		return 0;
+
+	if (mode != LWF_OPMODE_CLIENT && mode != LWF_OPMODE_ADHOC)
+		return 0;
+
+	sock = nl80211_wpactl_connect(ifname, &local);
+
+	if (sock < 0)
+		return 0;
+
+	va_start(ap, ifname);
+
+	/* clear all destination buffers */
+	va_copy(ap_cur, ap);
+
+	while ((search = va_arg(ap_cur, char *)) != NULL)
+	{
+		dest = va_arg(ap_cur, char *);
+		len  = va_arg(ap_cur, int);
+
+		memset(dest, 0, len);
+	}
+
+	va_end(ap_cur);
+
+	send(sock, "STATUS", 6, 0);
+
+	while (true)
+	{
+		if (nl80211_wpactl_recv(sock, buf, sizeof(buf)) <= 0)
+			break;
+
+		if (buf[0] == '<')
+			continue;
+
+		for (line = strtok_r(buf, "\n", &pos);
+			 line != NULL;
+			 line = strtok_r(NULL, "\n", &pos))
+		{
+			key = strtok(line, "=");
+			val = strtok(NULL, "\n");
+
+			if (!key || !val)
+				continue;
+
+			va_copy(ap_cur, ap);
+
+			while ((search = va_arg(ap_cur, char *)) != NULL)
+			{
+				dest = va_arg(ap_cur, char *);
+				len  = va_arg(ap_cur, int);
+
+				if (!strcmp(search, key))
+				{
+					strncpy(dest, val, len - 1);
+					found++;
+					break;
+				}
+			}
+
+			va_end(ap_cur);
+		}
+
+		break;
+	}
+
+	va_end(ap);
+
+	close(sock);
+	unlink(local.sun_path);
+
+	return found;
+}
+
+#define nl80211_wpactl_query(ifname, ...) \
+	__nl80211_wpactl_query(ifname, ##__VA_ARGS__, NULL)
+
+
+static char * nl80211_ifadd(const char *ifname)
+{
+	char path[PATH_MAX];
+	static __thread char nif[IFNAMSIZ] = { 0 };
+	struct nl80211_msg_conveyor *req;
+	FILE *sysfs;
+
+	req = nl80211_msg(ifname, NL80211_CMD_NEW_INTERFACE, 0);
+	if (req)
+	{
+		snprintf(nif, sizeof(nif), "tmp.%s", ifname);
+
+		NLA_PUT_STRING(req->msg, NL80211_ATTR_IFNAME, nif);
+		NLA_PUT_U32(req->msg, NL80211_ATTR_IFTYPE, NL80211_IFTYPE_STATION);
+
+		nl80211_send(req, NULL, NULL);
+
+		snprintf(path, sizeof(path) - 1,
+		         "/proc/sys/net/ipv6/conf/%s/disable_ipv6", nif);
+
+		if ((sysfs = fopen(path, "w")) != NULL)
+		{
+			fwrite("0\n", 1, 2, sysfs);
+			fclose(sysfs);
+		}
+
+		return nif;
+
+	nla_put_failure:
+		nl80211_free(req);
+	}
+
+	return NULL;
+}
+
+/*
+ * Station interface used to scan on behalf of the APs of a phy. It is named
+ * after the phy and left in place once created, so later scans only need to
+ * take it up and down again.
+ */
+static char * nl80211_scan_vif(const char *ifname)
+{
+	static __thread char nif[IFNAMSIZ] = { 0 };
+	struct nl80211_msg_conveyor *req;
+	char *phy;
+
+	if (!(phy = nl80211_ifname2phy(ifname)))
+		return NULL;
+
+	snprintf(nif, sizeof(nif), "tmp.%s", phy);
+
+	if (nl80211_ifindex(nif) > 0)
+		return nif;
+
+	req = nl80211_msg(ifname, NL80211_CMD_NEW_INTERFACE, 0);
+	if (!req)
+		return NULL;
+
+	NLA_PUT_STRING(req->msg, NL80211_ATTR_IFNAME, nif);
+	NLA_PUT_U32(req->msg, NL80211_ATTR_IFTYPE, NL80211_IFTYPE_STATION);
+
+	if (nl80211_send(req, NULL, NULL))
+		return NULL;
+
+	nls->links_valid = false;
+	lwf_ifmac(nif);
+
+	return nif;
+
+nla_put_failure:
+	nl80211_free(req);
+	return NULL;
+}
+
+static void nl80211_ifdel(const char *ifname)
+{
+	struct nl80211_msg_conveyor *req;
+	int err;
+
+	req = nl80211_msg(ifname, NL80211_CMD_DEL_INTERFACE, 0);
+	if (req)
+	{
+		NLA_PUT_STRING(req->msg, NL80211_ATTR_IFNAME, ifname);
+
+		nl80211_send(req, NULL, NULL);
+		return;
+
+	nla_put_failure:
+		nl80211_free(req);
+	}
+}
+
+static void nl80211_hostapd_hup(const char *ifname)
+{
+	int fd, pid = 0;
+	char buf[32];
+	char *phy = nl80211_ifname2phy(ifname);
+
+	if (phy)
+	{
+		snprintf(buf, sizeof(buf), "/var/run/wifi-%s.pid", phy);
+		if ((fd = open(buf, O_RDONLY)) >= 0)
+		{
+			if (read(fd, buf, sizeof(buf)) > 0)
+				pid = atoi(buf);
+
+			close(fd);
+		}
+
+		if (pid > 0)
+			kill(pid, 1);
+	}
+}
+
+
+/*
+ * Cheap wireless check: the resolver cache knows every wireless netdev, so
+ * a miss is a negative answer until a link event invalidates it. Without
+ * the cache the phy80211 sysfs link is checked instead.
+ */
+static int nl80211_probe(const char *ifname)
+{
+	char path[64];
+	int err;
+
+	if (!strncmp(ifname, "phy", 3))
+	{
+		snprintf(path, sizeof(path), "/sys/class/ieee80211/%s", ifname);
+
+		if (!access(path, F_OK))
+			return 1;
+
+		return !!nl80211_ifname2phy(ifname);
+	}
+	else if (!strncmp(ifname, "mon.", 4))
+	{
+		ifname += 4;
+	}
+
+	if (nl80211_link_get(ifname, &err))
+		return 1;
+	else if (err == -ENODEV)
+		return 0;
+
+	snprintf(path, sizeof(path), "/sys/class/net/%s/phy80211", ifname);
+
+	return !access(path, F_OK);
+}
+
+struct nl80211_ssid_bssid {
+	unsigned char *ssid;
+	unsigned char bssid[7];
+};
+
+static int nl80211_get_macaddr_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_ssid_bssid *sb = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+
+	if (tb[NL80211_ATTR_MAC]) {
+		sb->bssid[0] = 1;
+		memcpy(sb->bssid + 1, nla_data(tb[NL80211_ATTR_MAC]),
+		       sizeof(sb->bssid) - 1);
+	}
+
+	return NL_SKIP;
+}
+
+static int nl80211_get_ssid_bssid_cb(struct nl_msg *msg, void *arg)
+{
+	int ielen;
+	unsigned char *ie;
+	struct nl80211_ssid_bssid *sb = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+	struct nlattr *bss[NL80211_BSS_MAX + 1];
+
+	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
+		[NL80211_BSS_INFORMATION_ELEMENTS] = { 0 },
+		[NL80211_BSS_STATUS]               = { .type = NLA_U32 },
+	};
+
+	if (!tb[NL80211_ATTR_BSS] ||
+	    nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS],
+	                     bss_policy) ||
+	    !bss[NL80211_BSS_BSSID] ||
+	    !bss[NL80211_BSS_STATUS] ||
+	    !bss[NL80211_BSS_INFORMATION_ELEMENTS])
+	{
+		return NL_SKIP;
+	}
+
+	switch (nla_get_u32(bss[NL80211_BSS_STATUS]))
+	{
+	case NL80211_BSS_STATUS_ASSOCIATED:
+	case NL80211_BSS_STATUS_AUTHENTICATED:
+	case NL80211_BSS_STATUS_IBSS_JOINED:
+
+		if (sb->ssid)
+		{
+			ie = nla_data(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
+			ielen = nla_len(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
+
+			while (ielen >= 2 && ielen >= ie[1])
+			{
+				if (ie[0] == 0)
+				{
+					memcpy(sb->ssid, ie + 2, min(ie[1], LWF_ESSID_MAX_SIZE));
+					return NL_SKIP;
+				}
+
+				ielen -= ie[1] + 2;
+				ie += ie[1] + 2;
+			}
+		}
+		else
+		{
+			sb->bssid[0] = 1;
+			memcpy(sb->bssid + 1, nla_data(bss[NL80211_BSS_BSSID]), 6);
+			return NL_SKIP;
+		}
+
+	default:
+		return NL_SKIP;
+	}
+}
+
+static int nl80211_get_ssid(const char *ifname, char *buf)
+{
+	char *res;
+	struct nl80211_ssid_bssid sb = { .ssid = (unsigned char *)buf };
+
+	/* try to find ssid from scan dump results */
+	res = nl80211_phy2ifname(ifname);
+	sb.ssid[0] = 0;
+
+	nl80211_request(res ? res : ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+	                nl80211_get_ssid_bssid_cb, &sb);
+
+	/* failed, try to find from hostapd info */
+	if (sb.ssid[0] == 0)
+		nl80211_hostapd_query(ifname, "ssid", sb.ssid,
+		                      LWF_ESSID_MAX_SIZE + 1);
+
+	return (sb.ssid[0] == 0) ? -1 : 0;
+}
+
+static int nl80211_get_bssid(const char *ifname, char *buf)
+{
+	char *res, bssid[sizeof("FF:FF:FF:FF:FF:FF\0")];
+	struct nl80211_ssid_bssid sb = { };
+
+	res = nl80211_phy2ifname(ifname);
+
+	/* try to obtain mac address via NL80211_CMD_GET_INTERFACE */
+	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
+	                nl80211_get_macaddr_cb, &sb);
+
+	/* failed, try to find bssid from scan dump results */
+	if (sb.bssid[0] == 0)
+		nl80211_request(res ? res : ifname,
+		                NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                nl80211_get_ssid_bssid_cb, &sb);
+
+	/* failed, try to find mac from hostapd info */
+	if ((sb.bssid[0] == 0) &&
+	    nl80211_hostapd_query(ifname, "bssid", bssid, sizeof(bssid)))
+	{
+		sb.bssid[0] = 1;
+		sb.bssid[1] = strtol(&bssid[0],  NULL, 16);
+		sb.bssid[2] = strtol(&bssid[3],  NULL, 16);
+		sb.bssid[3] = strtol(&bssid[6],  NULL, 16);
+		sb.bssid[4] = strtol(&bssid[9],  NULL, 16);
+		sb.bssid[5] = strtol(&bssid[12], NULL, 16);
+		sb.bssid[6] = strtol(&bssid[15], NULL, 16);
+	}
+
+	if (sb.bssid[0])
+	{
+		sprintf(buf, "%02X:%02X:%02X:%02X:%02X:%02X",
+		        sb.bssid[1], sb.bssid[2], sb.bssid[3],
+		        sb.bssid[4], sb.bssid[5], sb.bssid[6]);
+
+		return 0;
+	}
+
+	return -1;
+}
+
+
+static int nl80211_get_frequency_scan_cb(struct nl_msg *msg, void *arg)
+{
+	int *freq = arg;
+	struct nlattr **attr = nl80211_parse(msg);
+	struct nlattr *binfo[NL80211_BSS_MAX + 1];
+
+	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
+		[NL80211_BSS_FREQUENCY] = { .type = NLA_U32 },
+		[NL80211_BSS_STATUS]    = { .type = NLA_U32 },
+	};
+
+	if (attr[NL80211_ATTR_BSS] &&
+	    !nla_parse_nested(binfo, NL80211_BSS_MAX,
+	                      attr[NL80211_ATTR_BSS], bss_policy))
+	{
+		if (binfo[NL80211_BSS_STATUS] && binfo[NL80211_BSS_FREQUENCY])
+			*freq = nla_get_u32(binfo[NL80211_BSS_FREQUENCY]);
+	}
+
+	return NL_SKIP;
+}
+
+static int nl80211_get_frequency_info_cb(struct nl_msg *msg, void *arg)
+{
+	int *freq = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+
+	if (tb[NL80211_ATTR_WIPHY_FREQ])
+		*freq = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ]);
+
+	return NL_SKIP;
+}
+
+static int nl80211_get_frequency(const char *ifname, int *buf)
+{
+	char *res, channel[4], hwmode[2];
+
+	/* try to find frequency from interface info */
+	res = nl80211_phy2ifname(ifname);
+	*buf = 0;
+
+	nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
+	                nl80211_get_frequency_info_cb, buf);
+
+	/* failed, try to find frequency from hostapd info */
+	if ((*buf == 0) &&
+	    nl80211_hostapd_query(ifname, "hw_mode", hwmode, sizeof(hwmode),
+	                                  "channel", channel, sizeof(channel)) == 2)
+	{
+		*buf = nl80211_channel2freq(atoi(channel), hwmode);
+	}
+
+	/* failed, try to find frequency from scan results */
+	if (*buf == 0)
+	{
+		res = nl80211_phy2ifname(ifname);
+
+		nl80211_request(res ? res : ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                nl80211_get_frequency_scan_cb, buf);
+	}
+
+	return (*buf == 0) ? -1 : 0;
+}
+
+static int nl80211_get_channel(const char *ifname, int *buf)
+{
+	if (!nl80211_get_frequency(ifname, buf))
+	{
+		*buf = nl80211_freq2channel(*buf);
+		return 0;
+	}
+
+	return -1;
+}
+
+static int nl80211_get_txpower_cb(struct nl_msg *msg, void *arg)
+{
+	int *buf = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+
+	if (tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL])
+		*buf = lwf_mbm2dbm(nla_get_u32(tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL]));
+
+	return NL_SKIP;
+}
+
+static int nl80211_get_txpower(const char *ifname, int *buf)
+{
+	char *res;
+
+	res = nl80211_phy2ifname(ifname);
+	*buf = 0;
+
+	if (nl80211_request(res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
+	                    nl80211_get_txpower_cb, buf))
+		return -1;
+
+	return 0;
+}
+
+
+static void nl80211_parse_station(struct nlattr **attr,
+                                  struct lwf_assoclist_entry *e);
+static int nl80211_station_dump(const char *ifname,
+                                int (*cb)(struct nl_msg *, void *), void *arg,
+                                const int *stop);
+
+static int nl80211_summary_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_sta_summary *a = arg;
+	struct lwf_assoclist_entry e;
+	int8_t *sig;
+
+	nl80211_parse_station(nl80211_parse(msg), &e);
+
+	a->s.count++;
+
+	if (e.signal && (sig = lwf_buf_add(&a->signals, sizeof(*sig))) != NULL)
+	{
+		*sig = e.signal;
+		a->mw_sum += pow(10.0, e.signal / 10.0);
+
+		if (!a->s.signal_count || e.signal < a->s.signal_min)
+			a->s.signal_min = e.signal;
+
+		if (!a->s.signal_count || e.signal > a->s.signal_max)
+			a->s.signal_max = e.signal;
+
+		a->s.signal_count++;
+	}
+
+	if (e.tx_rate.rate)
+	{
+		a->tx_sum += e.tx_rate.rate;
+		a->tx_samples++;
+	}
+
+	if (e.rx_rate.rate)
+	{
+		a->rx_sum += e.rx_rate.rate;
+		a->rx_samples++;
+	}
+
+	return NL_SKIP;
+}
+
+static int nl80211_summary_cmp(const void *a, const void *b)
+{
+	return *(const int8_t *)a - *(const int8_t *)b;
+}
+
+static void nl80211_summary_finish(struct nl80211_sta_summary *a)
+{
+	int8_t *sig = (int8_t *)a->signals.buf;
+	int n = a->s.signal_count;
+
+	if (n)
+	{
+		a->s.signal_mean = (int)lround(10.0 * log10(a->mw_sum / n));
+
+		qsort(sig, n, sizeof(*sig), nl80211_summary_cmp);
+		a->s.signal_median = (n % 2) ? sig[n / 2]
+		                             : (sig[n / 2 - 1] + sig[n / 2]) / 2;
+	}
+
+	if (a->tx_samples)
+		a->s.tx_rate_mean = a->tx_sum / a->tx_samples;
+
+	if (a->rx_samples)
+		a->s.rx_rate_mean = a->rx_sum / a->rx_samples;
+
+	lwf_buf_free(&a->signals);
+}
+
+static void nl80211_summary_store(const char *ifname,
+                                  const struct lwf_station_summary *s)
+{
+	struct nl80211_summary_node *n;
+
+	for (n = nls->summaries; n; n = n->next)
+		if (!strcmp(n->ifname, ifname))
+			break;
+
+	if (!n)
+	{
+		if (!(n = calloc(1, sizeof(*n))))
+			return;
+
+		strncpy(n->ifname, ifname, sizeof(n->ifname) - 1);
+		n->next = nls->summaries;
+		nls->summaries = n;
+	}
+
+	n->ts = nl80211_now();
+	n->s = *s;
+}
+
+static void nl80211_summary_free(void)
+{
+	struct nl80211_summary_node *n;
+
+	while ((n = nls->summaries) != NULL)
+	{
+		nls->summaries = n->next;
+		free(n);
+	}
+}
+
+/*
+ * Signal, bitrate and quality are all derived from one station dump per
+ * interface, which is reused for NL80211_SUMMARY_TTL ms.
+ */
+static int nl80211_get_station_summary(const char *ifname,
+                                       struct lwf_station_summary *s)
+{
+	struct nl80211_sta_summary a = { .signals = { .grow = 1 } };
+	struct nl80211_summary_node *n;
+	int64_t now = nl80211_now();
+
+	if (nl80211_init() < 0)
+		return -ENOLINK;
+
+	for (n = nls->summaries; n; n = n->next)
+	{
+		if (!strcmp(n->ifname, ifname) && now - n->ts < NL80211_SUMMARY_TTL)
+		{
+			*s = n->s;
+			return 0;
+		}
+	}
+
+	if (nl80211_station_dump(ifname, nl80211_summary_cb, &a, NULL))
+	{
+		lwf_buf_free(&a.signals);
+		return -1;
+	}
+
+	nl80211_summary_finish(&a);
+	nl80211_summary_store(ifname, &a.s);
+
+	*s = a.s;
+	return 0;
+}
+
+static int nl80211_get_bitrate(const char *ifname, int *buf)
+{
+	struct lwf_station_summary s;
+
+	if (!nl80211_get_station_summary(ifname, &s) && s.tx_rate_mean)
+	{
+		*buf = s.tx_rate_mean;
+		return 0;
+	}
+
+	return -1;
+}
+
+static int nl80211_get_signal(const char *ifname, int *buf)
+{
+	struct lwf_station_summary s;
+
+	if (!nl80211_get_station_summary(ifname, &s) && s.signal_count)
+	{
+		*buf = s.signal_mean;
+		return 0;
+	}
+
+	return -1;
+}
+
+static int nl80211_get_noise_cb(struct nl_msg *msg, void *arg)
+{
+	int8_t *noise = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+	struct nlattr *si[NL80211_SURVEY_INFO_MAX + 1];
+
+	static struct nla_policy sp[NL80211_SURVEY_INFO_MAX + 1] = {
+		[NL80211_SURVEY_INFO_FREQUENCY] = { .type = NLA_U32 },
+		[NL80211_SURVEY_INFO_NOISE]     = { .type = NLA_U8  },
+	};
+
+	if (!tb[NL80211_ATTR_SURVEY_INFO])
+		return NL_SKIP;
+
+	if (nla_parse_nested(si, NL80211_SURVEY_INFO_MAX,
+	                     tb[NL80211_ATTR_SURVEY_INFO], sp))
+		return NL_SKIP;
+
+	if (!si[NL80211_SURVEY_INFO_NOISE])
+		return NL_SKIP;
+
+	if (!*noise || si[NL80211_SURVEY_INFO_IN_USE])
+		*noise = (int8_t)nla_get_u8(si[NL80211_SURVEY_INFO_NOISE]);
+
+	return NL_SKIP;
+}
+
+
+static int nl80211_get_noise(const char *ifname, int *buf)
+{
+	int8_t noise = 0;
+
+	if (nl80211_request(ifname, NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
+	                    nl80211_get_noise_cb, &noise))
+		goto out;
+
+	*buf = noise;
+	return 0;
+
+out:
+	*buf = 0;
+	return -1;
+}
+
+static int nl80211_signal2quality(int signal)
+{
+	/* A positive signal level is usually just a quality
+	 * value, pass through as-is */
+	if (signal >= 0)
+		return signal;
+
+	/* The cfg80211 wext compat layer assumes a signal range
+	 * of -110 dBm to -40 dBm, the quality value is derived
+	 * by adding 110 to the signal level */
+	if (signal < -110)
+		signal = -110;
+	else if (signal > -40)
+		signal = -40;
+
+	return (signal + 110);
+}
+
+static int nl80211_get_quality(const char *ifname, int *buf)
+{
+	int signal;
+
+	if (!nl80211_get_signal(ifname, &signal))
+	{
+		*buf = nl80211_signal2quality(signal);
+		return 0;
+	}
+
+	return -1;
+}
+
+static int nl80211_get_quality_max(const char *ifname, int *buf)
+{
+	/* The cfg80211 wext compat layer assumes a maximum
+	 * quality of 70 */
+	*buf = 70;
+
+	return 0;
+}
+
+static int nl80211_check_wepkey(const char *key)
+{
+	if (key && *key)
+	{
+		switch (strlen(key))
+		{
+		case 5:
+		case 10:
+			return LWF_CIPHER_WEP40;
+
+		case 13:
+		case 26:
+			return LWF_CIPHER_WEP104;
+		}
+	}
+
+	return 0;
+}
+
+static int nl80211_get_encryption(const char *ifname, char *buf)
+{
+	char wpa[2], wpa_key_mgmt[16], wpa_pairwise[16], wpa_groupwise[16];
+	char auth_algs[2], wep_key0[27], wep_key1[27], wep_key2[27], wep_key3[27];
+
+	struct lwf_crypto_entry *c = (struct lwf_crypto_entry *)buf;
+
+	/* WPA supplicant */
+	if (nl80211_wpactl_query(ifname,
+			"pairwise_cipher", wpa_pairwise,  sizeof(wpa_pairwise),
+			"group_cipher",    wpa_groupwise, sizeof(wpa_groupwise),
+			"key_mgmt",        wpa_key_mgmt,  sizeof(wpa_key_mgmt)))
+	{
+		/* WEP */
+		if (!strcmp(wpa_key_mgmt, "NONE"))
+		{
+			if (strstr(wpa_pairwise, "WEP-40"))
+				c->pair_ciphers |= LWF_CIPHER_WEP40;
+			else if (strstr(wpa_pairwise, "WEP-104"))
+				c->pair_ciphers |= LWF_CIPHER_WEP104;
+
+			if (strstr(wpa_groupwise, "WEP-40"))
+				c->group_ciphers |= LWF_CIPHER_WEP40;
+			else if (strstr(wpa_groupwise, "WEP-104"))
+				c->group_ciphers |= LWF_CIPHER_WEP104;
+
+			c->enabled      = !!(c->pair_ciphers | c->group_ciphers);
+			c->auth_suites |= LWF_KMGMT_NONE;
+			c->auth_algs   |= LWF_AUTH_OPEN; /* XXX: assumption */
+		}
+
+		/* WPA */
+		else if (strstr(wpa_key_mgmt, "WPA"))
+		{
+			if (strstr(wpa_pairwise, "TKIP"))
+				c->pair_ciphers |= LWF_CIPHER_TKIP;
+			else if (strstr(wpa_pairwise, "CCMP"))
+				c->pair_ciphers |= LWF_CIPHER_CCMP;
+			else if (strstr(wpa_pairwise, "NONE"))
+				c->pair_ciphers |= LWF_CIPHER_NONE;
+			else if (strstr(wpa_pairwise, "WEP-40"))
+				c->pair_ciphers |= LWF_CIPHER_WEP40;
+			else if (strstr(wpa_pairwise, "WEP-104"))
+				c->pair_ciphers |= LWF_CIPHER_WEP104;
+
+			if (strstr(wpa_groupwise, "TKIP"))
+				c->group_ciphers |= LWF_CIPHER_TKIP;
+			else if (strstr(wpa_groupwise, "CCMP"))
+				c->group_ciphers |= LWF_CIPHER_CCMP;
+			else if (strstr(wpa_groupwise, "NONE"))
+				c->group_ciphers |= LWF_CIPHER_NONE;
+			else if (strstr(wpa_groupwise, "WEP-40"))
+				c->group_ciphers |= LWF_CIPHER_WEP40;
+			else if (strstr(wpa_groupwise, "WEP-104"))
+				c->group_ciphers |= LWF_CIPHER_WEP104;
+
+			if (strstr(wpa_key_mgmt, "WPA2"))
+				c->wpa_version = 2;
+			else if (strstr(wpa_key_mgmt, "WPA"))
+				c->wpa_version = 1;
+
+			if (strstr(wpa_key_mgmt, "PSK"))
+				c->auth_suites |= LWF_KMGMT_PSK;
+			else if (strstr(wpa_key_mgmt, "EAP") ||
+			         strstr(wpa_key_mgmt, "802.1X"))
+				c->auth_suites |= LWF_KMGMT_8021x;
+			else if (strstr(wpa_key_mgmt, "NONE"))
+				c->auth_suites |= LWF_KMGMT_NONE;
+
+			c->enabled = !!(c->wpa_version && c->auth_suites);
+		}
+
+		return 0;
+	}
+
+	/* Hostapd */
+	else if (nl80211_hostapd_query(ifname,
+				"wpa",          wpa,          sizeof(wpa),
+				"wpa_key_mgmt", wpa_key_mgmt, sizeof(wpa_key_mgmt),
+				"wpa_pairwise", wpa_pairwise, sizeof(wpa_pairwise),
+				"auth_algs",    auth_algs,    sizeof(auth_algs),
+				"wep_key0",     wep_key0,     sizeof(wep_key0),
+				"wep_key1",     wep_key1,     sizeof(wep_key1),
+				"wep_key2",     wep_key2,     sizeof(wep_key2),
+				"wep_key3",     wep_key3,     sizeof(wep_key3)))
+	{
+		c->wpa_version = wpa[0] ? atoi(wpa) : 0;
+
+		if (wpa_key_mgmt[0])
+		{
+			if (strstr(wpa_key_mgmt, "PSK"))
+				c->auth_suites |= LWF_KMGMT_PSK;
+
+			if (strstr(wpa_key_mgmt, "EAP"))
+				c->auth_suites |= LWF_KMGMT_8021x;
+
+			if (strstr(wpa_key_mgmt, "NONE"))
+				c->auth_suites |= LWF_KMGMT_NONE;
+		}
+		else
+		{
+			c->auth_suites |= LWF_KMGMT_PSK;
+		}
+
+		if (wpa_pairwise[0])
+		{
+			if (strstr(wpa_pairwise, "TKIP"))
+				c->pair_ciphers |= LWF_CIPHER_TKIP;
+
+			if (strstr(wpa_pairwise, "CCMP"))
+				c->pair_ciphers |= LWF_CIPHER_CCMP;
+
+			if (strstr(wpa_pairwise, "NONE"))
+				c->pair_ciphers |= LWF_CIPHER_NONE;
+		}
+
+		if (auth_algs[0])
+		{
+			switch(atoi(auth_algs))
+			{
+			case 1:
+				c->auth_algs |= LWF_AUTH_OPEN;
+				break;
+
+			case 2:
+				c->auth_algs |= LWF_AUTH_SHARED;
+				break;
+
+			case 3:
+				c->auth_algs |= LWF_AUTH_OPEN;
+				c->auth_algs |= LWF_AUTH_SHARED;
+				break;
+			}
+
+			c->pair_ciphers |= nl80211_check_wepkey(wep_key0);
+			c->pair_ciphers |= nl80211_check_wepkey(wep_key1);
+			c->pair_ciphers |= nl80211_check_wepkey(wep_key2);
+			c->pair_ciphers |= nl80211_check_wepkey(wep_key3);
+		}
+
+		c->group_ciphers = c->pair_ciphers;
+		c->enabled = (c->wpa_version || c->pair_ciphers) ? 1 : 0;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+static int nl80211_get_phyname(const char *ifname, char *buf)
+{
+	const char *name;
+
+	name = nl80211_ifname2phy(ifname);
+
+	if (name)
+	{
+		strcpy(buf, name);
+		return 0;
+	}
+	else if ((name = nl80211_phy2ifname(ifname)) != NULL)
+	{
+		name = nl80211_ifname2phy(name);
+
+		if (name)
+		{
+			strcpy(buf, ifname);
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+
+static void nl80211_parse_rateinfo(struct nlattr **ri,
+                                   struct lwf_rate_entry *re)
+{
+	if (ri[NL80211_RATE_INFO_BITRATE32])
+		re->rate = nla_get_u32(ri[NL80211_RATE_INFO_BITRATE32]) * 100;
+	else if (ri[NL80211_RATE_INFO_BITRATE])
+		re->rate = nla_get_u16(ri[NL80211_RATE_INFO_BITRATE]) * 100;
+
+	if (ri[NL80211_RATE_INFO_VHT_MCS])
+	{
+		re->is_vht = 1;
+		re->mcs = nla_get_u8(ri[NL80211_RATE_INFO_VHT_MCS]);
+
+		if (ri[NL80211_RATE_INFO_VHT_NSS])
+			re->nss = nla_get_u8(ri[NL80211_RATE_INFO_VHT_NSS]);
+	}
+	else if (ri[NL80211_RATE_INFO_MCS])
+	{
+		re->is_ht = 1;
+		re->mcs = nla_get_u8(ri[NL80211_RATE_INFO_MCS]);
+	}
+
+	if (ri[NL80211_RATE_INFO_5_MHZ_WIDTH])
+		re->mhz = 5;
+	else if (ri[NL80211_RATE_INFO_10_MHZ_WIDTH])
+		re->mhz = 10;
+	else if (ri[NL80211_RATE_INFO_40_MHZ_WIDTH])
+		re->mhz = 40;
+	else if (ri[NL80211_RATE_INFO_80_MHZ_WIDTH])
+		re->mhz = 80;
+	else if (ri[NL80211_RATE_INFO_80P80_MHZ_WIDTH] ||
+	         ri[NL80211_RATE_INFO_160_MHZ_WIDTH])
+		re->mhz = 160;
+	else
+		re->mhz = 20;
+
+	if (ri[NL80211_RATE_INFO_SHORT_GI])
+		re->is_short_gi = 1;
+
+	re->is_40mhz = (re->mhz == 40);
+}
+
+static int nl80211_get_survey_cb(struct nl_msg *msg, void *arg)
+{
+	struct lwf_buf *b = arg;
+	struct lwf_survey_entry *e;
+	struct nlattr **attr = nl80211_parse(msg);
+	struct nlattr *sinfo[NL80211_SURVEY_INFO_MAX + 1];
+	int rc;
+
+	static struct nla_policy survey_policy[NL80211_SURVEY_INFO_MAX + 1] = {
+		[NL80211_SURVEY_INFO_FREQUENCY] = { .type = NLA_U32 },
+		[NL80211_SURVEY_INFO_NOISE]  = { .type = NLA_U8     },
+		[NL80211_SURVEY_INFO_TIME] = { .type = NLA_U64   },
+		[NL80211_SURVEY_INFO_TIME_BUSY] = { .type = NLA_U64   },
+		[NL80211_SURVEY_INFO_TIME_EXT_BUSY] = { .type = NLA_U64   },
+		[NL80211_SURVEY_INFO_TIME_RX] = { .type = NLA_U64   },
+		[NL80211_SURVEY_INFO_TIME_TX] = { .type = NLA_U64   },
+	};
+
+	rc = nla_parse_nested(sinfo, NL80211_SURVEY_INFO_MAX,
+				attr[NL80211_ATTR_SURVEY_INFO],
+				survey_policy);
+	if (rc)
+		return NL_SKIP;
+
+	if (!(e = lwf_buf_add(b, sizeof(*e))))
+		return NL_SKIP;
+
+	memset(e, 0, sizeof(*e));
+
+	if (sinfo[NL80211_SURVEY_INFO_FREQUENCY])
+		e->mhz = nla_get_u32(sinfo[NL80211_SURVEY_INFO_FREQUENCY]);
+
+	if (sinfo[NL80211_SURVEY_INFO_NOISE])
+		e->noise = nla_get_u8(sinfo[NL80211_SURVEY_INFO_NOISE]);
+
+	if (sinfo[NL80211_SURVEY_INFO_TIME])
+		e->active_time = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME]);
+
+	if (sinfo[NL80211_SURVEY_INFO_TIME_BUSY])
+		e->busy_time = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_BUSY]);
+
+	if (sinfo[NL80211_SURVEY_INFO_TIME_EXT_BUSY])
+		e->busy_time_ext = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_EXT_BUSY]);
+
+	if (sinfo[NL80211_SURVEY_INFO_TIME_RX])
+		e->rxtime = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_RX]);
+
+	if (sinfo[NL80211_SURVEY_INFO_TIME_TX])
+		e->txtime = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_TX]);
+
+	return NL_SKIP;
+}
+
+
+static void plink_state_to_str(char *dst, unsigned state)
+{
+	switch (state) {
+	case NL80211_PLINK_LISTEN:
+		strcpy(dst, "LISTEN");
+		break;
+	case NL80211_PLINK_OPN_SNT:
+		strcpy(dst, "OPN_SNT");
+		break;
+	case NL80211_PLINK_OPN_RCVD:
+		strcpy(dst, "OPN_RCVD");
+		break;
+	case NL80211_PLINK_CNF_RCVD:
+		strcpy(dst, "CNF_RCVD");
+		break;
+	case NL80211_PLINK_ESTAB:
+		strcpy(dst, "ESTAB");
+		break;
+	case NL80211_PLINK_HOLDING:
+		strcpy(dst, "HOLDING");
+		break;
+	case NL80211_PLINK_BLOCKED:
+		strcpy(dst, "BLOCKED");
+		break;
+	default:
+		strcpy(dst, "UNKNOWN");
+		break;
+	}
+}
+
+static void power_mode_to_str(char *dst, struct nlattr *a)
+{
+	enum nl80211_mesh_power_mode pm = nla_get_u32(a);
+
+	switch (pm) {
+	case NL80211_MESH_POWER_ACTIVE:
+		strcpy(dst, "ACTIVE");
+		break;
+	case NL80211_MESH_POWER_LIGHT_SLEEP:
+		strcpy(dst, "LIGHT SLEEP");
+		break;
+	case NL80211_MESH_POWER_DEEP_SLEEP:
+		strcpy(dst, "DEEP SLEEP");
+		break;
+	default:
+		strcpy(dst, "UNKNOWN");
+		break;
+	}
+}
+
+static void nl80211_parse_station(struct nlattr **attr,
+                                  struct lwf_assoclist_entry *e)
+{
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
+	struct nl80211_sta_flag_update *sta_flags;
+
+	static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1] = {
+		[NL80211_STA_INFO_INACTIVE_TIME] = { .type = NLA_U32    },
+		[NL80211_STA_INFO_RX_PACKETS]    = { .type = NLA_U32    },
+		[NL80211_STA_INFO_TX_PACKETS]    = { .type = NLA_U32    },
+		[NL80211_STA_INFO_RX_BITRATE]    = { .type = NLA_NESTED },
+		[NL80211_STA_INFO_TX_BITRATE]    = { .type = NLA_NESTED },
+		[NL80211_STA_INFO_SIGNAL]        = { .type = NLA_U8     },
+		[NL80211_STA_INFO_SIGNAL_AVG]    = { .type = NLA_U8     },
+		[NL80211_STA_INFO_RX_BYTES]      = { .type = NLA_U32    },
+		[NL80211_STA_INFO_TX_BYTES]      = { .type = NLA_U32    },
+		[NL80211_STA_INFO_RX_BYTES64]    = { .type = NLA_U64    },
+		[NL80211_STA_INFO_TX_BYTES64]    = { .type = NLA_U64    },
+		[NL80211_STA_INFO_RX_DURATION]   = { .type = NLA_U64    },
+		[NL80211_STA_INFO_TX_DURATION]   = { .type = NLA_U64    },
+		[NL80211_STA_INFO_BEACON_RX]     = { .type = NLA_U64    },
+		[NL80211_STA_INFO_TX_RETRIES]    = { .type = NLA_U32    },
+		[NL80211_STA_INFO_TX_FAILED]     = { .type = NLA_U32    },
+		[NL80211_STA_INFO_CONNECTED_TIME]= { .type = NLA_U32    },
+		[NL80211_STA_INFO_RX_DROP_MISC]  = { .type = NLA_U64    },
+		[NL80211_STA_INFO_T_OFFSET]      = { .type = NLA_U64    },
+		[NL80211_STA_INFO_STA_FLAGS] =
+			{ .minlen = sizeof(struct nl80211_sta_flag_update) },
+		[NL80211_STA_INFO_EXPECTED_THROUGHPUT]   = { .type = NLA_U32    },
+		/* mesh */
+		[NL80211_STA_INFO_LLID]          = { .type = NLA_U16	},
+		[NL80211_STA_INFO_PLID]          = { .type = NLA_U16	},
+		[NL80211_STA_INFO_PLINK_STATE]   = { .type = NLA_U8	},
+		[NL80211_STA_INFO_LOCAL_PM]      = { .type = NLA_U32	},
+		[NL80211_STA_INFO_PEER_PM]       = { .type = NLA_U32	},
+		[NL80211_STA_INFO_NONPEER_PM]    = { .type = NLA_U32	},
+	};
+
+	static struct nla_policy rate_policy[NL80211_RATE_INFO_MAX + 1] = {
+		[NL80211_RATE_INFO_BITRATE]      = { .type = NLA_U16    },
+		[NL80211_RATE_INFO_MCS]          = { .type = NLA_U8     },
+		[NL80211_RATE_INFO_40_MHZ_WIDTH] = { .type = NLA_FLAG   },
+		[NL80211_RATE_INFO_SHORT_GI]     = { .type = NLA_FLAG   },
+	};
+
+	memset(e, 0, sizeof(*e));
+
+	if (attr[NL80211_ATTR_MAC])
+		memcpy(e->mac, nla_data(attr[NL80211_ATTR_MAC]), 6);
+
+	if (attr[NL80211_ATTR_STA_INFO] &&
+	    !nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
+	                      attr[NL80211_ATTR_STA_INFO], stats_policy))
+	{
+		if (sinfo[NL80211_STA_INFO_SIGNAL])
+			e->signal = nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]);
+
+		if (sinfo[NL80211_STA_INFO_SIGNAL_AVG])
+			e->signal_avg = nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL_AVG]);
+
+		if (sinfo[NL80211_STA_INFO_INACTIVE_TIME])
+			e->inactive = nla_get_u32(sinfo[NL80211_STA_INFO_INACTIVE_TIME]);
+
+		if (sinfo[NL80211_STA_INFO_CONNECTED_TIME])
+			e->connected_time = nla_get_u32(sinfo[NL80211_STA_INFO_CONNECTED_TIME]);
+
+		if (sinfo[NL80211_STA_INFO_RX_PACKETS])
+			e->rx_packets = nla_get_u32(sinfo[NL80211_STA_INFO_RX_PACKETS]);
+
+		if (sinfo[NL80211_STA_INFO_TX_PACKETS])
+			e->tx_packets = nla_get_u32(sinfo[NL80211_STA_INFO_TX_PACKETS]);
+
+		if (sinfo[NL80211_STA_INFO_RX_BITRATE] &&
+		    !nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX,
+		                      sinfo[NL80211_STA_INFO_RX_BITRATE], rate_policy))
+			nl80211_parse_rateinfo(rinfo, &e->rx_rate);
+
+		if (sinfo[NL80211_STA_INFO_TX_BITRATE] &&
+		    !nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX,
+		                      sinfo[NL80211_STA_INFO_TX_BITRATE], rate_policy))
+			nl80211_parse_rateinfo(rinfo, &e->tx_rate);
+
+		/* prefer the 64 bit byte counters, the 32 bit ones wrap quickly */
+		if (sinfo[NL80211_STA_INFO_RX_BYTES64] &&
+		    sinfo[NL80211_STA_INFO_TX_BYTES64])
+		{
+			e->rx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_RX_BYTES64]);
+			e->tx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_TX_BYTES64]);
+			e->is_bytes64 = 1;
+		}
+		else
+		{
+			if (sinfo[NL80211_STA_INFO_RX_BYTES])
+				e->rx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]);
+
+			if (sinfo[NL80211_STA_INFO_TX_BYTES])
+				e->tx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]);
+		}
+
+		if (sinfo[NL80211_STA_INFO_RX_DURATION])
+			e->rx_duration = nla_get_u64(sinfo[NL80211_STA_INFO_RX_DURATION]);
+
+		if (sinfo[NL80211_STA_INFO_TX_DURATION])
+			e->tx_duration = nla_get_u64(sinfo[NL80211_STA_INFO_TX_DURATION]);
+
+		if (sinfo[NL80211_STA_INFO_BEACON_RX])
+			e->beacon_rx = nla_get_u64(sinfo[NL80211_STA_INFO_BEACON_RX]);
+
+		if (sinfo[NL80211_STA_INFO_TX_RETRIES])
+			e->tx_retries = nla_get_u32(sinfo[NL80211_STA_INFO_TX_RETRIES]);
+
+		if (sinfo[NL80211_STA_INFO_TX_FAILED])
+			e->tx_failed = nla_get_u32(sinfo[NL80211_STA_INFO_TX_FAILED]);
+
+		if (sinfo[NL80211_STA_INFO_T_OFFSET])
+			e->t_offset = nla_get_u64(sinfo[NL80211_STA_INFO_T_OFFSET]);
+
+		if (sinfo[NL80211_STA_INFO_RX_DROP_MISC])
+			e->rx_drop_misc = nla_get_u64(sinfo[NL80211_STA_INFO_RX_DROP_MISC]);
+
+		if (sinfo[NL80211_STA_INFO_EXPECTED_THROUGHPUT])
+			e->thr = nla_get_u32(sinfo[NL80211_STA_INFO_EXPECTED_THROUGHPUT]);
+
+		/* mesh */
+		if (sinfo[NL80211_STA_INFO_LLID])
+			e->llid = nla_get_u16(sinfo[NL80211_STA_INFO_LLID]);
+
+		if (sinfo[NL80211_STA_INFO_PLID])
+			e->plid = nla_get_u16(sinfo[NL80211_STA_INFO_PLID]);
+
+		if (sinfo[NL80211_STA_INFO_PLINK_STATE])
+			plink_state_to_str(e->plink_state,
+				nla_get_u8(sinfo[NL80211_STA_INFO_PLINK_STATE]));
+
+		if (sinfo[NL80211_STA_INFO_LOCAL_PM])
+			power_mode_to_str(e->local_ps, sinfo[NL80211_STA_INFO_LOCAL_PM]);
+		if (sinfo[NL80211_STA_INFO_PEER_PM])
+			power_mode_to_str(e->peer_ps, sinfo[NL80211_STA_INFO_PEER_PM]);
+		if (sinfo[NL80211_STA_INFO_NONPEER_PM])
+			power_mode_to_str(e->nonpeer_ps, sinfo[NL80211_STA_INFO_NONPEER_PM]);
+
+		/* Station flags */
+		if (sinfo[NL80211_STA_INFO_STA_FLAGS])
+		{
+			sta_flags = (struct nl80211_sta_flag_update *)
+				nla_data(sinfo[NL80211_STA_INFO_STA_FLAGS]);
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_AUTHORIZED) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_AUTHORIZED))
+				e->is_authorized = 1;
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_AUTHENTICATED) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_AUTHENTICATED))
+				e->is_authenticated = 1;
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_SHORT_PREAMBLE) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_SHORT_PREAMBLE))
+				e->is_preamble_short = 1;
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_WME) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_WME))
+				e->is_wme = 1;
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_MFP) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_MFP))
+				e->is_mfp = 1;
+
+			if (sta_flags->mask & BIT(NL80211_STA_FLAG_TDLS_PEER) &&
+			    sta_flags->set & BIT(NL80211_STA_FLAG_TDLS_PEER))
+				e->is_tdls = 1;
+		}
+	}
+
+	e->noise = 0; /* filled in by caller */
+}
+
+static int nl80211_get_assoclist_cb(struct nl_msg *msg, void *arg)
+{
+	struct lwf_buf *b = arg;
+	struct lwf_assoclist_entry *e;
+
+	if ((e = lwf_buf_add(b, sizeof(*e))) != NULL)
+		nl80211_parse_station(nl80211_parse(msg), e);
+
+	return NL_SKIP;
+}
+
+struct nl80211_station_iter {
+	int (*cb)(const struct lwf_assoclist_entry *, void *);
+	void *ctx;
+	int noise;
+	int stop;
+};
+
+static int nl80211_station_iter_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_station_iter *it = arg;
+	struct lwf_assoclist_entry e;
+
+	/* keep draining the dump once the consumer is done, so that no stale
+	 * replies are left on the socket */
+	if (it->stop)
+		return NL_SKIP;
+
+	nl80211_parse_station(nl80211_parse(msg), &e);
+	e.noise = it->noise;
+
+	if (it->cb(&e, it->ctx))
+		it->stop = 1;
+
+	return NL_SKIP;
+}
+
+/*
+ * Dump the stations of ifname and of its ifname.staX WDS companions.
+ * Returns the error of the ifname dump, a WDS interface failing to dump
+ * is skipped. If stop is given, no further interfaces are dumped once the
+ * callback has set it.
+ */
+static int nl80211_station_dump(const char *ifname,
+                                int (*cb)(struct nl_msg *, void *), void *arg,
+                                const int *stop)
+{
+	DIR *d;
+	struct dirent *de;
+	int rv, err = 0;
+
+	if ((d = opendir("/sys/class/net")) == NULL)
+		return -1;
+
+	while ((de = readdir(d)) != NULL && !(stop && *stop))
+	{
+		if (!strncmp(de->d_name, ifname, strlen(ifname)) &&
+		    (!de->d_name[strlen(ifname)] ||
+		     !strncmp(&de->d_name[strlen(ifname)], ".sta", 4)))
+		{
+			rv = nl80211_request(de->d_name, NL80211_CMD_GET_STATION,
+			                     NLM_F_DUMP, cb, arg);
+
+			if (!de->d_name[strlen(ifname)])
+				err = rv;
+		}
+	}
+
+	closedir(d);
+	return err;
+}
+
+static int nl80211_station_foreach(const char *ifname,
+	int (*cb)(const struct lwf_assoclist_entry *, void *), void *ctx)
+{
+	struct nl80211_station_iter it = { .cb = cb, .ctx = ctx };
+
+	if (nl80211_get_noise(ifname, &it.noise))
+		it.noise = 0;
+
+	return nl80211_station_dump(ifname, nl80211_station_iter_cb, &it,
+	                            &it.stop);
+}
+
+struct nl80211_station_get {
+	struct lwf_assoclist_entry *e;
+	int found;
+};
+
+static int nl80211_station_get_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_station_get *g = arg;
+
+	nl80211_parse_station(nl80211_parse(msg), g->e);
+	g->found = 1;
+
+	return NL_SKIP;
+}
+
+/*
+ * A non-dump GET_STATION for the AP interface also finds stations sitting
+ * on its AP_VLAN (ifname.staX) interfaces, so one request is enough.
+ */
+static int nl80211_station_get(const char *ifname, const uint8_t *mac,
+                               struct lwf_assoclist_entry *e)
+{
+	struct nl80211_station_get g = { .e = e };
+	struct nl80211_msg_conveyor *req;
+	int err;
+
+	memset(e, 0, sizeof(*e));
+
+	req = nl80211_msg(ifname, NL80211_CMD_GET_STATION, 0);
+	if (!req)
+		return -ENODEV;
+
+	NLA_PUT(req->msg, NL80211_ATTR_MAC, 6, mac);
+
+	if ((err = nl80211_send(req, nl80211_station_get_cb, &g)) != 0)
+		return err;
+
+	return g.found ? 0 : -ENOENT;
+
+nla_put_failure:
+	nl80211_free(req);
+	return -ENOMEM;
+}
+
+static int nl80211_list_survey(const char *ifname, struct lwf_buf *b)
+{
+	if (nl80211_request(ifname, NL80211_CMD_GET_SURVEY,
+	                    NLM_F_DUMP, nl80211_get_survey_cb, b))
+		b->len = 0;
+
+	return 0;
+}
+
+static struct nl80211_sta_watch * nl80211_sta_watch_find(const char *ifname)
+{
+	struct nl80211_sta_watch *w;
+
+	for (w = nls ? nls->sta_watch : NULL; w; w = w->next)
+	{
+		if (!strcmp(w->ifname, ifname))
+			return w;
+
+		/* WDS stations show up on ifname.staX interfaces */
+		if (!strncmp(ifname, w->ifname, strlen(w->ifname)) &&
+		    !strncmp(ifname + strlen(w->ifname), ".sta", 4))
+			return w;
+	}
+
+	return NULL;
+}
+
+static struct nl80211_sta_node ** nl80211_sta_watch_lookup(
+	struct nl80211_sta_watch *w, const uint8_t *mac)
+{
+	struct nl80211_sta_node **n;
+
+	for (n = &w->stations; *n; n = &(*n)->next)
+		if (!memcmp((*n)->e.mac, mac, 6))
+			break;
+
+	return n;
+}
+
+static int nl80211_sta_watch_dump_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_sta_watch *w = arg;
+	struct nl80211_sta_node *n;
+
+	if ((n = malloc(sizeof(*n))) != NULL)
+	{
+		nl80211_parse_station(nl80211_parse(msg), &n->e);
+		n->next = w->stations;
+		w->stations = n;
+	}
+
+	return NL_SKIP;
+}
+
+static void nl80211_sta_watch_flush(struct nl80211_sta_watch *w)
+{
+	struct nl80211_sta_node *n, *next;
+
+	for (n = w->stations; n; n = next)
+	{
+		next = n->next;
+		free(n);
+	}
+
+	w->stations = NULL;
+}
+
+/* Events were lost, rebuild the station tables from a fresh dump */
+static void nl80211_sta_watch_resync(void)
+{
+	struct nl80211_sta_watch *w;
+
+	for (w = nls ? nls->sta_watch : NULL; w; w = w->next)
+	{
+		nl80211_sta_watch_flush(w);
+		nl80211_station_dump(w->ifname, nl80211_sta_watch_dump_cb, w, NULL);
+	}
+}
+
+static void nl80211_sta_watch_event(int cmd, struct nlattr **attr)
+{
+	struct lwf_station_notify n = { 0 };
+	struct nl80211_sta_watch *w;
+	struct nl80211_sta_node **p, *node;
+
+	if (!attr[NL80211_ATTR_IFINDEX] ||
+	    !if_indextoname(nla_get_u32(attr[NL80211_ATTR_IFINDEX]), n.ifname) ||
+	    !(w = nl80211_sta_watch_find(n.ifname)))
+		return;
+
+	if (attr[NL80211_ATTR_MAC])
+		memcpy(n.mac, nla_data(attr[NL80211_ATTR_MAC]), 6);
+
+	switch (cmd)
+	{
+	case NL80211_CMD_NEW_STATION:
+		n.type = LWF_STATION_NOTIFY_NEW;
+
+		p = nl80211_sta_watch_lookup(w, n.mac);
+
+		if (!*p && (*p = calloc(1, sizeof(**p))) == NULL)
+			return;
+
+		nl80211_parse_station(attr, &(*p)->e);
+		n.entry = &(*p)->e;
+		break;
+
+	case NL80211_CMD_DEL_STATION:
+		n.type = LWF_STATION_NOTIFY_DEL;
+		break;
+
+	case NL80211_CMD_CONN_FAILED:
+		n.type = LWF_STATION_NOTIFY_CONN_FAILED;
+
+		if (attr[NL80211_ATTR_CONN_FAILED_REASON])
+			n.reason = nla_get_u32(attr[NL80211_ATTR_CONN_FAILED_REASON]);
+		break;
+
+	case NL80211_CMD_DISCONNECT:
+		n.type = LWF_STATION_NOTIFY_DISCONNECT;
+
+		if (attr[NL80211_ATTR_REASON_CODE])
+			n.reason = nla_get_u16(attr[NL80211_ATTR_REASON_CODE]);
+
+		/* a client lost its AP, which is the only station it knows */
+		if (!attr[NL80211_ATTR_MAC])
+			nl80211_sta_watch_flush(w);
+		break;
+
+	default:
+		return;
+	}
+
+	if (n.type == LWF_STATION_NOTIFY_DEL ||
+	    n.type == LWF_STATION_NOTIFY_DISCONNECT)
+	{
+		p = nl80211_sta_watch_lookup(w, n.mac);
+
+		if ((node = *p) != NULL)
+		{
+			*p = node->next;
+			free(node);
+		}
+	}
+
+	if (w->cb)
+		w->cb(&n, w->ctx);
+}
+
+static void nl80211_mlme_free(void)
+{
+	if (nls->nl_mlme_cb)
+		nl_cb_put(nls->nl_mlme_cb);
+
+	if (nls->nl_mlme)
+		nl_socket_free(nls->nl_mlme);
+
+	nls->nl_mlme_cb = NULL;
+	nls->nl_mlme = NULL;
+	nls->mlme_group = 0;
+}
+
+/*
+ * Station events get a socket of their own, so that only
+ * nl80211_dispatch() ever reads them and runs the watch callbacks.
+ */
+static int nl80211_mlme_init(void)
+{
+	int id, fd;
+
+	if (nls->nl_mlme)
+		return 0;
+
+	if ((id = nl80211_get_group("nl80211", "mlme")) < 0)
+		return id;
+
+	nls->nl_mlme = nl_socket_alloc();
+	nls->nl_mlme_cb = nl_cb_alloc(NL_CB_DEFAULT);
+
+	if (!nls->nl_mlme || !nls->nl_mlme_cb)
+		goto err;
+
+	if (genl_connect(nls->nl_mlme))
+		goto err;
+
+	fd = nl_socket_get_fd(nls->nl_mlme);
+	if (fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) < 0 ||
+	    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+		goto err;
+
+	nl_socket_set_buffer_size(nls->nl_mlme, NL80211_EVENT_RCVBUF, 0);
+
+	if (nl_socket_add_membership(nls->nl_mlme, id))
+		goto err;
+
+	nl_cb_set(nls->nl_mlme_cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM,
+	          nl80211_wait_seq_check, NULL);
+	nl_cb_set(nls->nl_mlme_cb, NL_CB_VALID, NL_CB_CUSTOM,
+	          nl80211_mlme_cb, NULL);
+
+	nls->mlme_group = id;
+
+	return 0;
+
+err:
+	nl80211_mlme_free();
+
+	return -ENOLINK;
+}
+
+static void nl80211_mlme_process(void)
+{
+	struct pollfd pfd = { .events = POLLIN };
+	int err;
+
+	if (!nls->nl_mlme)
+		return;
+
+	pfd.fd = nl_socket_get_fd(nls->nl_mlme);
+
+	while (poll(&pfd, 1, 0) > 0)
+	{
+		err = nl_recvmsgs(nls->nl_mlme, nls->nl_mlme_cb);
+
+		/* receive buffer overrun, events were lost */
+		if (err < 0 && err != -NLE_AGAIN)
+		{
+			nl80211_sta_watch_resync();
+			break;
+		}
+	}
+}
+
+static int nl80211_station_watch(const char *ifname,
+	void (*cb)(const struct lwf_station_notify *, void *), void *ctx)
+{
+	struct nl80211_sta_watch *w;
+
+	if (nl80211_init() < 0 || nl80211_mlme_init())
+		return -ENOLINK;
+
+	if ((w = nl80211_sta_watch_find(ifname)) == NULL ||
+	    strcmp(w->ifname, ifname))
+	{
+		if (!(w = calloc(1, sizeof(*w))))
+			return -ENOMEM;
+
+		strncpy(w->ifname, ifname, sizeof(w->ifname) - 1);
+		w->next = nls->sta_watch;
+		nls->sta_watch = w;
+	}
+
+	w->cb = cb;
+	w->ctx = ctx;
+
+	/*
+	 * Events already queued for this interface are replayed on top of the
+	 * dump by the next dispatch, which the station table tolerates.
+	 */
+	nl80211_sta_watch_flush(w);
+	nl80211_station_dump(ifname, nl80211_sta_watch_dump_cb, w, NULL);
+
+	return nl_socket_get_fd(nls->nl_mlme);
+}
+
+static int nl80211_station_unwatch(const char *ifname)
+{
+	struct nl80211_sta_watch *w, **prev;
+
+	for (prev = nls ? &nls->sta_watch : NULL; prev && (w = *prev); prev = &w->next)
+	{
+		if (strcmp(w->ifname, ifname))
+			continue;
+
+		*prev = w->next;
+		nl80211_sta_watch_free(w);
+
+		if (!nls->sta_watch)
+			nl80211_mlme_free();
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int nl80211_dispatch(void)
+{
+	if (nls)
+	{
+		nl80211_events_process();
+		nl80211_mlme_process();
+	}
+
+	return 0;
+}
+
+static int nl80211_list_watched(const char *ifname, struct lwf_buf *b)
+{
+	struct nl80211_sta_watch *w;
+	struct nl80211_sta_node *n;
+	struct lwf_assoclist_entry *e;
+
+	nl80211_dispatch();
+
+	for (w = nls ? nls->sta_watch : NULL; w; w = w->next)
+		if (!strcmp(w->ifname, ifname))
+			break;
+
+	if (!w)
+		return -ENOENT;
 
-			case 2:
-				c->auth_algs |= LWF_AUTH_SHARED;
-				break;
+	for (n = w->stations; n; n = n->next)
+		if ((e = lwf_buf_add(b, sizeof(*e))) != NULL)
+			*e = n->e;
 
-			case 3:
-				c->auth_algs |= LWF_AUTH_OPEN;
-				c->auth_algs |= LWF_AUTH_SHARED;
-				break;
-			}
+	return 0;
+}
 
-			c->pair_ciphers |= nl80211_check_wepkey(wep_key0);
-			c->pair_ciphers |= nl80211_check_wepkey(wep_key1);
-			c->pair_ciphers |= nl80211_check_wepkey(wep_key2);
-			c->pair_ciphers |= nl80211_check_wepkey(wep_key3);
-		}
+static int nl80211_list_assoc(const char *ifname, struct lwf_buf *b)
+{
+	int i, n, len, noise = 0;
+	struct lwf_assoclist_entry *e;
 
-		c->group_ciphers = c->pair_ciphers;
-		c->enabled = (c->wpa_version || c->pair_ciphers) ? 1 : 0;
+	if (nl80211_station_dump(ifname, nl80211_get_assoclist_cb, b, NULL))
+		return -1;
 
-		return 0;
-	}
+	/* only touch the entries which actually made it into the buffer */
+	len = (b->len < b->size) ? b->len : b->size;
+	n = len / sizeof(*e);
 
-	return -1;
+	if (!nl80211_get_noise(ifname, &noise))
+		for (i = 0, e = (struct lwf_assoclist_entry *)b->buf; i < n; i++, e++)
+			e->noise = noise;
+
+	return 0;
 }
 
-static int nl80211_get_phyname(const char *ifname, char *buf)
+static int nl80211_list_txpwr(const char *ifname, struct lwf_buf *b)
 {
-	const char *name;
+	int i, band = -1, ch_cur;
+	int dbm_max = -1, dbm_cur;
+	struct nl80211_wiphy_info *info;
+	struct nl80211_wiphy_freq *f;
+	struct lwf_txpwrlist_entry *e;
 
-	name = nl80211_ifname2phy(ifname);
+	if (nl80211_get_channel(ifname, &ch_cur))
+		ch_cur = 0;
 
-	if (name)
-	{
-		strcpy(buf, name);
-		return 0;
-	}
-	else if ((name = nl80211_phy2ifname(ifname)) != NULL)
+	if (!(info = nl80211_wiphy_get(ifname)))
+		return -1;
+
+	/* the first matching frequency of each band wins, later bands override */
+	for (i = 0; i < info->freqs_count; i++)
 	{
-		name = nl80211_ifname2phy(name);
+		f = &info->freqs[i];
 
-		if (name)
+		if (f->band == band)
+			continue;
+
+		if ((!ch_cur || (nl80211_freq2channel(f->mhz) == ch_cur)) &&
+		    f->max_txpower >= 0)
 		{
-			strcpy(buf, ifname);
-			return 0;
+			dbm_max = f->max_txpower;
+			band = f->band;
 		}
 	}
 
-	return -1;
-}
-
-
-static void nl80211_parse_rateinfo(struct nlattr **ri,
-                                   struct lwf_rate_entry *re)
-{
-	if (ri[NL80211_RATE_INFO_BITRATE32])
-		re->rate = nla_get_u32(ri[NL80211_RATE_INFO_BITRATE32]) * 100;
-	else if (ri[NL80211_RATE_INFO_BITRATE])
-		re->rate = nla_get_u16(ri[NL80211_RATE_INFO_BITRATE]) * 100;
-
-	if (ri[NL80211_RATE_INFO_VHT_MCS])
+	for (dbm_cur = 0; dbm_cur < dbm_max; dbm_cur++)
 	{
-		re->is_vht = 1;
-		re->mcs = nla_get_u8(ri[NL80211_RATE_INFO_VHT_MCS]);
+		if (!(e = lwf_buf_add(b, sizeof(*e))))
+			continue;
 
-		if (ri[NL80211_RATE_INFO_VHT_NSS])
-			re->nss = nla_get_u8(ri[NL80211_RATE_INFO_VHT_NSS]);
+		e->dbm = dbm_cur;
+		e->mw  = lwf_dbm2mw(dbm_cur);
 	}
-	else if (ri[NL80211_RATE_INFO_MCS])
+
+	if ((e = lwf_buf_add(b, sizeof(*e))) != NULL)
 	{
-		re->is_ht = 1;
-		re->mcs = nla_get_u8(ri[NL80211_RATE_INFO_MCS]);
+		e->dbm = dbm_max;
+		e->mw  = lwf_dbm2mw(dbm_max);
 	}
 
-	if (ri[NL80211_RATE_INFO_5_MHZ_WIDTH])
-		re->mhz = 5;
-	else if (ri[NL80211_RATE_INFO_10_MHZ_WIDTH])
-		re->mhz = 10;
-	else if (ri[NL80211_RATE_INFO_40_MHZ_WIDTH])
-		re->mhz = 40;
-	else if (ri[NL80211_RATE_INFO_80_MHZ_WIDTH])
-		re->mhz = 80;
-	else if (ri[NL80211_RATE_INFO_80P80_MHZ_WIDTH] ||
-	         ri[NL80211_RATE_INFO_160_MHZ_WIDTH])
-		re->mhz = 160;
-	else
-		re->mhz = 20;
-
-	if (ri[NL80211_RATE_INFO_SHORT_GI])
-		re->is_short_gi = 1;
-
-	re->is_40mhz = (re->mhz == 40);
+	return 0;
 }
 
-static int nl80211_get_survey_cb(struct nl_msg *msg, void *arg)
+static void nl80211_get_scancrypto(const char *spec,
+	struct lwf_crypto_entry *c)
 {
-	struct nl80211_array_buf *arr = arg;
-	struct lwf_survey_entry *e = arr->buf;
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *sinfo[NL80211_SURVEY_INFO_MAX + 1];
-	int rc;
+	if (strstr(spec, "WPA") || strstr(spec, "WEP"))
+	{
+		c->enabled = 1;
 
-	static struct nla_policy survey_policy[NL80211_SURVEY_INFO_MAX + 1] = {
-		[NL80211_SURVEY_INFO_FREQUENCY] = { .type = NLA_U32 },
-		[NL80211_SURVEY_INFO_NOISE]  = { .type = NLA_U8     },
-		[NL80211_SURVEY_INFO_TIME] = { .type = NLA_U64   },
-		[NL80211_SURVEY_INFO_TIME_BUSY] = { .type = NLA_U64   },
-		[NL80211_SURVEY_INFO_TIME_EXT_BUSY] = { .type = NLA_U64   },
-		[NL80211_SURVEY_INFO_TIME_RX] = { .type = NLA_U64   },
-		[NL80211_SURVEY_INFO_TIME_TX] = { .type = NLA_U64   },
-	};
+		if (strstr(spec, "WPA2-") && strstr(spec, "WPA-"))
+			c->wpa_version = 3;
 
-	rc = nla_parse_nested(sinfo, NL80211_SURVEY_INFO_MAX,
-				attr[NL80211_ATTR_SURVEY_INFO],
-				survey_policy);
-	if (rc)
-		return NL_SKIP;
+		else if (strstr(spec, "WPA2"))
+			c->wpa_version = 2;
 
-	/* advance to end of array */
-	e += arr->count;
-	memset(e, 0, sizeof(*e));
+		else if (strstr(spec, "WPA"))
+			c->wpa_version = 1;
 
-	if (sinfo[NL80211_SURVEY_INFO_FREQUENCY])
-		e->mhz = nla_get_u32(sinfo[NL80211_SURVEY_INFO_FREQUENCY]);
+		else if (strstr(spec, "WEP"))
+			c->auth_algs = LWF_AUTH_OPEN | LWF_AUTH_SHARED;
 
-	if (sinfo[NL80211_SURVEY_INFO_NOISE])
-		e->noise = nla_get_u8(sinfo[NL80211_SURVEY_INFO_NOISE]);
 
-	if (sinfo[NL80211_SURVEY_INFO_TIME])
-		e->active_time = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME]);
+		if (strstr(spec, "PSK"))
+			c->auth_suites |= LWF_KMGMT_PSK;
 
-	if (sinfo[NL80211_SURVEY_INFO_TIME_BUSY])
-		e->busy_time = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_BUSY]);
+		if (strstr(spec, "802.1X") || strstr(spec, "EAP"))
+			c->auth_suites |= LWF_KMGMT_8021x;
 
-	if (sinfo[NL80211_SURVEY_INFO_TIME_EXT_BUSY])
-		e->busy_time_ext = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_EXT_BUSY]);
+		if (strstr(spec, "WPA-NONE"))
+			c->auth_suites |= LWF_KMGMT_NONE;
 
-	if (sinfo[NL80211_SURVEY_INFO_TIME_RX])
-		e->rxtime = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_RX]);
 
-	if (sinfo[NL80211_SURVEY_INFO_TIME_TX])
-		e->txtime = nla_get_u64(sinfo[NL80211_SURVEY_INFO_TIME_TX]);
+		if (strstr(spec, "TKIP"))
+			c->pair_ciphers |= LWF_CIPHER_TKIP;
 
-	arr->count++;
-	return NL_SKIP;
+		if (strstr(spec, "CCMP"))
+			c->pair_ciphers |= LWF_CIPHER_CCMP;
+
+		if (strstr(spec, "WEP-40"))
+			c->pair_ciphers |= LWF_CIPHER_WEP40;
+
+		if (strstr(spec, "WEP-104"))
+			c->pair_ciphers |= LWF_CIPHER_WEP104;
+
+		c->group_ciphers = c->pair_ciphers;
+	}
+	else
+	{
+		c->enabled = 0;
+	}
 }
 
 
-static void plink_state_to_str(char *dst, unsigned state)
+static void nl80211_ie_ssid(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
 {
-	switch (state) {
-	case NL80211_PLINK_LISTEN:
-		strcpy(dst, "LISTEN");
-		break;
-	case NL80211_PLINK_OPN_SNT:
-		strcpy(dst, "OPN_SNT");
-		break;
-	case NL80211_PLINK_OPN_RCVD:
-		strcpy(dst, "OPN_RCVD");
-		break;
-	case NL80211_PLINK_CNF_RCVD:
-		strcpy(dst, "CNF_RCVD");
-		break;
-	case NL80211_PLINK_ESTAB:
-		strcpy(dst, "ESTAB");
-		break;
-	case NL80211_PLINK_HOLDING:
-		strcpy(dst, "HOLDING");
-		break;
-	case NL80211_PLINK_BLOCKED:
-		strcpy(dst, "BLOCKED");
-		break;
-	default:
-		strcpy(dst, "UNKNOWN");
-		break;
+	if (c->e->ssid[0] == 0)
+	{
+		len = min(len, LWF_ESSID_MAX_SIZE);
+		memcpy(c->e->ssid, d, len);
+		c->e->ssid[len] = 0;
 	}
 }
 
-static void power_mode_to_str(char *dst, struct nlattr *a)
+static void nl80211_ie_rsn(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
 {
-	enum nl80211_mesh_power_mode pm = nla_get_u32(a);
-
-	switch (pm) {
-	case NL80211_MESH_POWER_ACTIVE:
-		strcpy(dst, "ACTIVE");
-		break;
-	case NL80211_MESH_POWER_LIGHT_SLEEP:
-		strcpy(dst, "LIGHT SLEEP");
-		break;
-	case NL80211_MESH_POWER_DEEP_SLEEP:
-		strcpy(dst, "DEEP SLEEP");
-		break;
-	default:
-		strcpy(dst, "UNKNOWN");
-		break;
-	}
+	lwf_parse_rsn(&c->e->crypto, (unsigned char *)d, len,
+	              LWF_CIPHER_CCMP, LWF_KMGMT_8021x);
 }
 
-static int nl80211_get_assoclist_cb(struct nl_msg *msg, void *arg)
+static void nl80211_ie_vendor(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
 {
-	struct nl80211_array_buf *arr = arg;
-	struct lwf_assoclist_entry *e = arr->buf;
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
-	struct nlattr *rinfo[NL80211_RATE_INFO_MAX + 1];
-	struct nl80211_sta_flag_update *sta_flags;
+	static unsigned char ms_oui[3] = { 0x00, 0x50, 0xf2 };
 
-	static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1] = {
-		[NL80211_STA_INFO_INACTIVE_TIME] = { .type = NLA_U32    },
-		[NL80211_STA_INFO_RX_PACKETS]    = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_PACKETS]    = { .type = NLA_U32    },
-		[NL80211_STA_INFO_RX_BITRATE]    = { .type = NLA_NESTED },
-		[NL80211_STA_INFO_TX_BITRATE]    = { .type = NLA_NESTED },
-		[NL80211_STA_INFO_SIGNAL]        = { .type = NLA_U8     },
-		[NL80211_STA_INFO_SIGNAL_AVG]    = { .type = NLA_U8     },
-		[NL80211_STA_INFO_RX_BYTES]      = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_BYTES]      = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_RETRIES]    = { .type = NLA_U32    },
-		[NL80211_STA_INFO_TX_FAILED]     = { .type = NLA_U32    },
-		[NL80211_STA_INFO_CONNECTED_TIME]= { .type = NLA_U32    },
-		[NL80211_STA_INFO_RX_DROP_MISC]  = { .type = NLA_U64    },
-		[NL80211_STA_INFO_T_OFFSET]      = { .type = NLA_U64    },
-		[NL80211_STA_INFO_STA_FLAGS] =
-			{ .minlen = sizeof(struct nl80211_sta_flag_update) },
-		[NL80211_STA_INFO_EXPECTED_THROUGHPUT]   = { .type = NLA_U32    },
-		/* mesh */
-		[NL80211_STA_INFO_LLID]          = { .type = NLA_U16	},
-		[NL80211_STA_INFO_PLID]          = { .type = NLA_U16	},
-		[NL80211_STA_INFO_PLINK_STATE]   = { .type = NLA_U8	},
-		[NL80211_STA_INFO_LOCAL_PM]      = { .type = NLA_U32	},
-		[NL80211_STA_INFO_PEER_PM]       = { .type = NLA_U32	},
-		[NL80211_STA_INFO_NONPEER_PM]    = { .type = NLA_U32	},
-	};
+	if (!memcmp(d, ms_oui, 3) && d[3] == 1)
+		lwf_parse_rsn(&c->e->crypto, (unsigned char *)d + 4, len - 4,
+		              LWF_CIPHER_TKIP, LWF_KMGMT_PSK);
+}
 
-	static struct nla_policy rate_policy[NL80211_RATE_INFO_MAX + 1] = {
-		[NL80211_RATE_INFO_BITRATE]      = { .type = NLA_U16    },
-		[NL80211_RATE_INFO_MCS]          = { .type = NLA_U8     },
-		[NL80211_RATE_INFO_40_MHZ_WIDTH] = { .type = NLA_FLAG   },
-		[NL80211_RATE_INFO_SHORT_GI]     = { .type = NLA_FLAG   },
-	};
+static void nl80211_ie_rates(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	uint32_t rate;
+	int i;
 
-	/* advance to end of array */
-	e += arr->count;
-	memset(e, 0, sizeof(*e));
+	/* 500 kbit/s units, the top bit marks basic rates */
+	for (i = 0; i < len; i++)
+	{
+		/* BSS membership selectors 122-127 (HE, SAE H2E, ..., VHT, HT) */
+		if ((d[i] & 0x7f) >= 122)
+			continue;
 
-	if (attr[NL80211_ATTR_MAC])
-		memcpy(e->mac, nla_data(attr[NL80211_ATTR_MAC]), 6);
+		if ((rate = (d[i] & 0x7f) * 500) > c->x->max_rate)
+			c->x->max_rate = rate;
+	}
+}
 
-	if (attr[NL80211_ATTR_STA_INFO] &&
-	    !nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
-	                      attr[NL80211_ATTR_STA_INFO], stats_policy))
-	{
-		if (sinfo[NL80211_STA_INFO_SIGNAL])
-			e->signal = nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]);
+static void nl80211_ie_country(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	c->x->country[0] = d[0];
+	c->x->country[1] = d[1];
+	c->x->country[2] = 0;
+}
+
+static void nl80211_ie_bss_load(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	c->x->sta_count = d[0] | (d[1] << 8);
+	c->x->utilization = d[2];
+}
 
-		if (sinfo[NL80211_STA_INFO_SIGNAL_AVG])
-			e->signal_avg = nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL_AVG]);
+static void nl80211_ie_ht_caps(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	int nss;
 
-		if (sinfo[NL80211_STA_INFO_INACTIVE_TIME])
-			e->inactive = nla_get_u32(sinfo[NL80211_STA_INFO_INACTIVE_TIME]);
+	/* one byte of the rx MCS bitmask per spatial stream */
+	for (nss = 4; nss > 0 && !d[3 + nss - 1]; nss--);
 
-		if (sinfo[NL80211_STA_INFO_CONNECTED_TIME])
-			e->connected_time = nla_get_u32(sinfo[NL80211_STA_INFO_CONNECTED_TIME]);
+	c->x->max_nss = max(c->x->max_nss, nss);
+}
 
-		if (sinfo[NL80211_STA_INFO_RX_PACKETS])
-			e->rx_packets = nla_get_u32(sinfo[NL80211_STA_INFO_RX_PACKETS]);
+static void nl80211_ie_ht_oper(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	c->x->primary_channel = d[0];
 
-		if (sinfo[NL80211_STA_INFO_TX_PACKETS])
-			e->tx_packets = nla_get_u32(sinfo[NL80211_STA_INFO_TX_PACKETS]);
+	switch (d[1] & 3)
+	{
+	case 1: c->x->secondary_offset = 1;  break;
+	case 3: c->x->secondary_offset = -1; break;
+	}
 
-		if (sinfo[NL80211_STA_INFO_RX_BITRATE] &&
-		    !nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX,
-		                      sinfo[NL80211_STA_INFO_RX_BITRATE], rate_policy))
-			nl80211_parse_rateinfo(rinfo, &e->rx_rate);
+	if (c->x->secondary_offset && (d[1] & (1 << 2)))
+		c->x->width = max(c->x->width, 40);
+}
 
-		if (sinfo[NL80211_STA_INFO_TX_BITRATE] &&
-		    !nla_parse_nested(rinfo, NL80211_RATE_INFO_MAX,
-		                      sinfo[NL80211_STA_INFO_TX_BITRATE], rate_policy))
-			nl80211_parse_rateinfo(rinfo, &e->tx_rate);
+static void nl80211_ie_vht_caps(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	uint16_t map = d[4] | (d[5] << 8);
+	int nss;
 
-		if (sinfo[NL80211_STA_INFO_RX_BYTES])
-			e->rx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]);
+	/* two bits per spatial stream, 3 means not supported */
+	for (nss = 8; nss > 0 && ((map >> ((nss - 1) * 2)) & 3) == 3; nss--);
 
-		if (sinfo[NL80211_STA_INFO_TX_BYTES])
-			e->tx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]);
+	c->x->max_nss = max(c->x->max_nss, nss);
+}
 
-		if (sinfo[NL80211_STA_INFO_TX_RETRIES])
-			e->tx_retries = nla_get_u32(sinfo[NL80211_STA_INFO_TX_RETRIES]);
+static void nl80211_ie_vht_oper(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	switch (d[0])
+	{
+	case 1:
+		/* 160 and 80+80 may be signalled by a second segment */
+		c->x->width = max(c->x->width, d[2] ? 160 : 80);
+		break;
 
-		if (sinfo[NL80211_STA_INFO_TX_FAILED])
-			e->tx_failed = nla_get_u32(sinfo[NL80211_STA_INFO_TX_FAILED]);
+	case 2:
+	case 3:
+		c->x->width = 160;
+		break;
+	}
+}
 
-		if (sinfo[NL80211_STA_INFO_T_OFFSET])
-			e->t_offset = nla_get_u64(sinfo[NL80211_STA_INFO_T_OFFSET]);
+static void nl80211_ie_ext_caps(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	if (len >= 3 && (d[2] & (1 << 3)))
+		c->x->caps |= LWF_BSS_CAP_BTM;
+}
 
-		if (sinfo[NL80211_STA_INFO_RX_DROP_MISC])
-			e->rx_drop_misc = nla_get_u64(sinfo[NL80211_STA_INFO_RX_DROP_MISC]);
+static void nl80211_ie_rm_caps(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	c->x->caps |= LWF_BSS_CAP_RRM;
+}
 
-		if (sinfo[NL80211_STA_INFO_EXPECTED_THROUGHPUT])
-			e->thr = nla_get_u32(sinfo[NL80211_STA_INFO_EXPECTED_THROUGHPUT]);
+static void nl80211_ie_mobility(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	c->x->caps |= LWF_BSS_CAP_FT;
+}
 
-		/* mesh */
-		if (sinfo[NL80211_STA_INFO_LLID])
-			e->llid = nla_get_u16(sinfo[NL80211_STA_INFO_LLID]);
+/* HE operation, only the 6 GHz operation information carries the channel */
+static void nl80211_ie_extension(struct nl80211_ie_ctx *c, const uint8_t *d, int len)
+{
+	static const uint16_t widths[4] = { 20, 40, 80, 160 };
+	uint32_t params;
+	int off = 7;
 
-		if (sinfo[NL80211_STA_INFO_PLID])
-			e->plid = nla_get_u16(sinfo[NL80211_STA_INFO_PLID]);
+	if (d[0] != 36 || len < off)
+		return;
 
-		if (sinfo[NL80211_STA_INFO_PLINK_STATE])
-			plink_state_to_str(e->plink_state,
-				nla_get_u8(sinfo[NL80211_STA_INFO_PLINK_STATE]));
+	params = d[1] | (d[2] << 8) | (d[3] << 16);
 
-		if (sinfo[NL80211_STA_INFO_LOCAL_PM])
-			power_mode_to_str(e->local_ps, sinfo[NL80211_STA_INFO_LOCAL_PM]);
-		if (sinfo[NL80211_STA_INFO_PEER_PM])
-			power_mode_to_str(e->peer_ps, sinfo[NL80211_STA_INFO_PEER_PM]);
-		if (sinfo[NL80211_STA_INFO_NONPEER_PM])
-			power_mode_to_str(e->nonpeer_ps, sinfo[NL80211_STA_INFO_NONPEER_PM]);
+	if (params & (1 << 14))
+		off += 3;
 
-		/* Station flags */
-		if (sinfo[NL80211_STA_INFO_STA_FLAGS])
-		{
-			sta_flags = (struct nl80211_sta_flag_update *)
-				nla_data(sinfo[NL80211_STA_INFO_STA_FLAGS]);
+	if (params & (1 << 15))
+		off += 1;
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_AUTHORIZED) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_AUTHORIZED))
-				e->is_authorized = 1;
+	if (!(params & (1 << 17)) || len < off + 5)
+		return;
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_AUTHENTICATED) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_AUTHENTICATED))
-				e->is_authenticated = 1;
+	c->x->primary_channel = d[off];
+	c->x->width = max(c->x->width, widths[d[off + 1] & 3]);
+}
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_SHORT_PREAMBLE) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_SHORT_PREAMBLE))
-				e->is_preamble_short = 1;
+/*
+ * Decoders by element ID with the minimum payload they read. Those without
+ * an info group fill the basic scan entry and always run, the others only
+ * when the group was requested.
+ */
+static const struct nl80211_ie_handler nl80211_ie_handlers[256] = {
+	[0]   = { 0,  0,                     nl80211_ie_ssid },
+	[1]   = { 1,  LWF_SCAN_INFO_RATES,   nl80211_ie_rates },
+	[7]   = { 2,  LWF_SCAN_INFO_COUNTRY, nl80211_ie_country },
+	[11]  = { 5,  LWF_SCAN_INFO_LOAD,    nl80211_ie_bss_load },
+	[45]  = { 7,  LWF_SCAN_INFO_RATES,   nl80211_ie_ht_caps },
+	[48]  = { 0,  0,                     nl80211_ie_rsn },
+	[50]  = { 1,  LWF_SCAN_INFO_RATES,   nl80211_ie_rates },
+	[54]  = { 3,  LWF_SCAN_INFO_CAPS,    nl80211_ie_mobility },
+	[61]  = { 2,  LWF_SCAN_INFO_CHANNEL, nl80211_ie_ht_oper },
+	[70]  = { 5,  LWF_SCAN_INFO_CAPS,    nl80211_ie_rm_caps },
+	[114] = { 0,  0,                     nl80211_ie_ssid },
+	[127] = { 1,  LWF_SCAN_INFO_CAPS,    nl80211_ie_ext_caps },
+	[191] = { 6,  LWF_SCAN_INFO_RATES,   nl80211_ie_vht_caps },
+	[192] = { 3,  LWF_SCAN_INFO_CHANNEL, nl80211_ie_vht_oper },
+	[221] = { 4,  0,                     nl80211_ie_vendor },
+	[255] = { 1,  LWF_SCAN_INFO_CHANNEL, nl80211_ie_extension },
+};
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_WME) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_WME))
-				e->is_wme = 1;
+static void nl80211_parse_ies(const uint8_t *ie, int ielen,
+                              struct nl80211_ie_ctx *c)
+{
+	const struct nl80211_ie_handler *h;
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_MFP) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_MFP))
-				e->is_mfp = 1;
+	while (ielen >= 2 && ielen >= ie[1] + 2)
+	{
+		h = &nl80211_ie_handlers[ie[0]];
 
-			if (sta_flags->mask & BIT(NL80211_STA_FLAG_TDLS_PEER) &&
-			    sta_flags->set & BIT(NL80211_STA_FLAG_TDLS_PEER))
-				e->is_tdls = 1;
-		}
+		if (h->parse && ie[1] >= h->min_len && (!h->info || (c->info & h->info)))
+			h->parse(c, ie + 2, ie[1]);
+
+		ielen -= ie[1] + 2;
+		ie += ie[1] + 2;
 	}
+}
 
-	e->noise = 0; /* filled in by caller */
-	arr->count++;
+static struct nlattr ** nl80211_parse_bss(struct nl_msg *msg)
+{
+	struct nlattr **tb = nl80211_parse(msg);
+	static __thread struct nlattr *bss[NL80211_BSS_MAX + 1];
 
-	return NL_SKIP;
+	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
+		[NL80211_BSS_TSF]                  = { .type = NLA_U64 },
+		[NL80211_BSS_FREQUENCY]            = { .type = NLA_U32 },
+		[NL80211_BSS_BSSID]                = { 0 },
+		[NL80211_BSS_BEACON_INTERVAL]      = { .type = NLA_U16 },
+		[NL80211_BSS_CAPABILITY]           = { .type = NLA_U16 },
+		[NL80211_BSS_INFORMATION_ELEMENTS] = { 0 },
+		[NL80211_BSS_SIGNAL_MBM]           = { .type = NLA_U32 },
+		[NL80211_BSS_SIGNAL_UNSPEC]        = { .type = NLA_U8  },
+		[NL80211_BSS_STATUS]               = { .type = NLA_U32 },
+		[NL80211_BSS_SEEN_MS_AGO]          = { .type = NLA_U32 },
+		[NL80211_BSS_BEACON_IES]           = { 0 },
+	};
+
+	if (!tb[NL80211_ATTR_BSS] ||
+		nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS],
+		                 bss_policy) ||
+		!bss[NL80211_BSS_BSSID])
+	{
+		return NULL;
+	}
+
+	return bss;
 }
 
-static int nl80211_get_survey(const char *ifname, char *buf, int *len)
+static void nl80211_fill_scan_entry(struct nlattr **bss,
+                                    struct nl80211_ie_ctx *c)
 {
-	struct nl80211_array_buf arr = { .buf = buf, .count = 0 };
-	int rc;
+	int8_t rssi;
+	uint16_t caps;
+	struct lwf_scanlist_entry *e = c->e;
 
-	rc = nl80211_request(ifname, NL80211_CMD_GET_SURVEY,
-			NLM_F_DUMP, nl80211_get_survey_cb, &arr);
-	if (!rc)
-		*len = (arr.count * sizeof(struct lwf_survey_entry));
+	if (bss[NL80211_BSS_CAPABILITY])
+		caps = nla_get_u16(bss[NL80211_BSS_CAPABILITY]);
 	else
-		*len = 0;
+		caps = 0;
 
-	return 0;
-}
+	memset(e, 0, sizeof(*e));
+	memcpy(e->mac, nla_data(bss[NL80211_BSS_BSSID]), 6);
 
-static int nl80211_get_assoclist(const char *ifname, char *buf, int *len)
-{
-	DIR *d;
-	int i, noise = 0;
-	struct dirent *de;
-	struct nl80211_array_buf arr = { .buf = buf, .count = 0 };
-	struct lwf_assoclist_entry *e;
+	if (caps & (1<<1))
+		e->mode = LWF_OPMODE_ADHOC;
+	else if (caps & (1<<0))
+		e->mode = LWF_OPMODE_MASTER;
+	else
+		e->mode = LWF_OPMODE_MESHPOINT;
 
-	if ((d = opendir("/sys/class/net")) != NULL)
+	if (caps & (1<<4))
+		e->crypto.enabled = 1;
+
+	if (bss[NL80211_BSS_FREQUENCY])
+		e->channel = nl80211_freq2channel(nla_get_u32(
+			bss[NL80211_BSS_FREQUENCY]));
+
+	if (bss[NL80211_BSS_INFORMATION_ELEMENTS])
+		nl80211_parse_ies(nla_data(bss[NL80211_BSS_INFORMATION_ELEMENTS]),
+		                  nla_len(bss[NL80211_BSS_INFORMATION_ELEMENTS]), c);
+
+	if (bss[NL80211_BSS_SIGNAL_MBM])
 	{
-		while ((de = readdir(d)) != NULL)
-		{
-			if (!strncmp(de->d_name, ifname, strlen(ifname)) &&
-			    (!de->d_name[strlen(ifname)] ||
-			     !strncmp(&de->d_name[strlen(ifname)], ".sta", 4)))
-			{
-				nl80211_request(de->d_name, NL80211_CMD_GET_STATION,
-				                NLM_F_DUMP, nl80211_get_assoclist_cb, &arr);
-			}
-		}
+		e->signal =
+			(uint8_t)((int32_t)nla_get_u32(bss[NL80211_BSS_SIGNAL_MBM]) / 100);
 
-		closedir(d);
+		rssi = e->signal - 0x100;
 
-		if (!nl80211_get_noise(ifname, &noise))
-			for (i = 0, e = arr.buf; i < arr.count; i++, e++)
-				e->noise = noise;
+		if (rssi < -110)
+			rssi = -110;
+		else if (rssi > -40)
+			rssi = -40;
 
-		*len = (arr.count * sizeof(struct lwf_assoclist_entry));
-		return 0;
+		e->quality = (rssi + 110);
+		e->quality_max = 70;
 	}
 
-	return -1;
+	if (e->crypto.enabled && !e->crypto.wpa_version)
+	{
+		e->crypto.auth_algs    = LWF_AUTH_OPEN | LWF_AUTH_SHARED;
+		e->crypto.pair_ciphers = LWF_CIPHER_WEP40 | LWF_CIPHER_WEP104;
+	}
 }
 
-static int nl80211_get_txpwrlist_cb(struct nl_msg *msg, void *arg)
+static int nl80211_get_scanlist_cb(struct nl_msg *msg, void *arg)
 {
-	int *dbm_max = arg;
-	int ch_cur, ch_cmp, bands_remain, freqs_remain;
+	struct lwf_buf *b = arg;
+	struct nl80211_ie_ctx c = { };
+	struct nlattr **bss = nl80211_parse_bss(msg);
 
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *bands[NL80211_BAND_ATTR_MAX + 1];
-	struct nlattr *freqs[NL80211_FREQUENCY_ATTR_MAX + 1];
-	struct nlattr *band, *freq;
+	if (!bss || !(c.e = lwf_buf_add(b, sizeof(*c.e))))
+		return NL_SKIP;
 
-	static struct nla_policy freq_policy[NL80211_FREQUENCY_ATTR_MAX + 1] = {
-		[NL80211_FREQUENCY_ATTR_FREQ]         = { .type = NLA_U32  },
-		[NL80211_FREQUENCY_ATTR_DISABLED]     = { .type = NLA_FLAG },
-		[NL80211_FREQUENCY_ATTR_PASSIVE_SCAN] = { .type = NLA_FLAG },
-		[NL80211_FREQUENCY_ATTR_NO_IBSS]      = { .type = NLA_FLAG },
-		[NL80211_FREQUENCY_ATTR_RADAR]        = { .type = NLA_FLAG },
-		[NL80211_FREQUENCY_ATTR_MAX_TX_POWER] = { .type = NLA_U32  },
-	};
+	nl80211_fill_scan_entry(bss, &c);
 
-	ch_cur = *dbm_max; /* value int* is initialized with channel by caller */
-	*dbm_max = -1;
+	return NL_SKIP;
+}
 
-	nla_for_each_nested(band, attr[NL80211_ATTR_WIPHY_BANDS], bands_remain)
-	{
-		nla_parse(bands, NL80211_BAND_ATTR_MAX, nla_data(band),
-		          nla_len(band), NULL);
+static int nl80211_get_scanlist_v2_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_scan_out *out = arg;
+	struct nl80211_ie_ctx c = { .info = out->info };
+	struct nlattr **bss = nl80211_parse_bss(msg);
 
-		nla_for_each_nested(freq, bands[NL80211_BAND_ATTR_FREQS], freqs_remain)
-		{
-			nla_parse(freqs, NL80211_FREQUENCY_ATTR_MAX,
-			          nla_data(freq), nla_len(freq), freq_policy);
+	if (!bss || !(c.x = lwf_buf_add(out->b, sizeof(*c.x))))
+		return NL_SKIP;
 
-			ch_cmp = nl80211_freq2channel(nla_get_u32(
-				freqs[NL80211_FREQUENCY_ATTR_FREQ]));
+	memset(c.x, 0, sizeof(*c.x));
+	c.x->info = out->info;
+	c.e = &c.x->e;
 
-			if ((!ch_cur || (ch_cmp == ch_cur)) &&
-			    freqs[NL80211_FREQUENCY_ATTR_MAX_TX_POWER])
-			{
-				*dbm_max = (int)(0.01 * nla_get_u32(
-					freqs[NL80211_FREQUENCY_ATTR_MAX_TX_POWER]));
+	nl80211_fill_scan_entry(bss, &c);
 
-				break;
-			}
-		}
+	/* without operation elements the BSS uses its beacon channel only */
+	if (out->info & LWF_SCAN_INFO_CHANNEL)
+	{
+		if (!c.x->primary_channel)
+			c.x->primary_channel = c.e->channel;
+
+		if (!c.x->width)
+			c.x->width = 20;
 	}
 
 	return NL_SKIP;
 }
 
-static int nl80211_get_txpwrlist(const char *ifname, char *buf, int *len)
+/* Abort a running scan, even if the cancel hook of the context fires */
+static int nl80211_abort_scan(const char *ifname)
 {
-	int err, ch_cur;
-	int dbm_max = -1, dbm_cur, dbm_cnt;
-	struct nl80211_msg_conveyor *req;
-	struct lwf_txpwrlist_entry entry;
+	struct lwf_ctx *ctx = lwf_ctx_get();
+	int (*cancel)(void *) = ctx->cancel;
+	int err;
 
-	if (nl80211_get_channel(ifname, &ch_cur))
-		ch_cur = 0;
+	ctx->cancel = NULL;
+	err = nl80211_request(ifname, NL80211_CMD_ABORT_SCAN, 0, NULL, NULL);
+	ctx->cancel = cancel;
+
+	return err;
+}
 
-	/* initialize the value pointer with channel for callback */
-	dbm_max = ch_cur;
+static uint32_t nl80211_scan_flags(uint32_t flags)
+{
+	uint32_t nl_flags = 0;
 
-	err = nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
-	                      nl80211_get_txpwrlist_cb, &dbm_max);
+	if (flags & LWF_SCAN_FLAG_LOW_PRIORITY)
+		nl_flags |= NL80211_SCAN_FLAG_LOW_PRIORITY;
 
-	if (!err)
-	{
-		for (dbm_cur = 0, dbm_cnt = 0;
-		     dbm_cur < dbm_max;
-		     dbm_cur++, dbm_cnt++)
-		{
-			entry.dbm = dbm_cur;
-			entry.mw  = lwf_dbm2mw(dbm_cur);
+	if (flags & LWF_SCAN_FLAG_FLUSH)
+		nl_flags |= NL80211_SCAN_FLAG_FLUSH;
 
-			memcpy(&buf[dbm_cnt * sizeof(entry)], &entry, sizeof(entry));
-		}
+	if (flags & LWF_SCAN_FLAG_AP)
+		nl_flags |= NL80211_SCAN_FLAG_AP;
 
-		entry.dbm = dbm_max;
-		entry.mw  = lwf_dbm2mw(dbm_max);
+	return nl_flags;
+}
 
-		memcpy(&buf[dbm_cnt * sizeof(entry)], &entry, sizeof(entry));
-		dbm_cnt++;
+static int nl80211_get_mode(const char *ifname, int *buf);
 
-		*len = dbm_cnt * sizeof(entry);
-		return 0;
-	}
+static bool nl80211_ap_scan(const char *ifname)
+{
+	struct nl80211_wiphy_info *info;
+	int mode;
 
-	return -1;
+	if (nl80211_get_mode(ifname, &mode) || mode != LWF_OPMODE_MASTER)
+		return false;
+
+	info = nl80211_wiphy_get(ifname);
+
+	return info && (info->feature_flags & NL80211_FEATURE_AP_SCAN);
 }
 
-static void nl80211_get_scancrypto(const char *spec,
-	struct lwf_crypto_entry *c)
+static int nl80211_scan_trigger(const char *ifname,
+                                const struct lwf_scan_params *p)
 {
-	if (strstr(spec, "WPA") || strstr(spec, "WEP"))
-	{
-		c->enabled = 1;
+	struct nl80211_msg_conveyor *req;
+	struct nlattr *nest;
+	uint32_t flags = p ? nl80211_scan_flags(p->flags) : 0;
+	int i;
 
-		if (strstr(spec, "WPA2-") && strstr(spec, "WPA-"))
-			c->wpa_version = 3;
+	/* a beaconing interface is only allowed to scan off-channel with the
+	 * AP flag, which drivers announce with the AP scan feature. This may
+	 * issue requests itself, so it has to be settled before building ours */
+	if (nl80211_ap_scan(ifname))
+		flags |= NL80211_SCAN_FLAG_AP;
 
-		else if (strstr(spec, "WPA2"))
-			c->wpa_version = 2;
+	req = nl80211_msg(ifname, NL80211_CMD_TRIGGER_SCAN, 0);
+	if (!req)
+		return -ENODEV;
 
-		else if (strstr(spec, "WPA"))
-			c->wpa_version = 1;
+	if (p && p->n_freqs > 0)
+	{
+		if (!(nest = nla_nest_start(req->msg, NL80211_ATTR_SCAN_FREQUENCIES)))
+			goto nla_put_failure;
 
-		else if (strstr(spec, "WEP"))
-			c->auth_algs = LWF_AUTH_OPEN | LWF_AUTH_SHARED;
+		for (i = 0; i < p->n_freqs && i < LWF_SCAN_MAX_FREQS; i++)
+			NLA_PUT_U32(req->msg, i + 1, p->freqs[i]);
 
+		nla_nest_end(req->msg, nest);
+	}
 
-		if (strstr(spec, "PSK"))
-			c->auth_suites |= LWF_KMGMT_PSK;
+	if (p && p->n_ssids > 0)
+	{
+		if (!(nest = nla_nest_start(req->msg, NL80211_ATTR_SCAN_SSIDS)))
+			goto nla_put_failure;
 
-		if (strstr(spec, "802.1X") || strstr(spec, "EAP"))
-			c->auth_suites |= LWF_KMGMT_8021x;
+		for (i = 0; i < p->n_ssids && i < LWF_SCAN_MAX_SSIDS; i++)
+			NLA_PUT(req->msg, i + 1, strnlen(p->ssids[i], LWF_ESSID_MAX_SIZE),
+			        p->ssids[i]);
 
-		if (strstr(spec, "WPA-NONE"))
-			c->auth_suites |= LWF_KMGMT_NONE;
+		nla_nest_end(req->msg, nest);
+	}
 
+	if (p && p->duration)
+		NLA_PUT_U16(req->msg, NL80211_ATTR_MEASUREMENT_DURATION, p->duration);
 
-		if (strstr(spec, "TKIP"))
-			c->pair_ciphers |= LWF_CIPHER_TKIP;
+	if (flags)
+		NLA_PUT_U32(req->msg, NL80211_ATTR_SCAN_FLAGS, flags);
 
-		if (strstr(spec, "CCMP"))
-			c->pair_ciphers |= LWF_CIPHER_CCMP;
+	return nl80211_send(req, NULL, NULL);
+
+nla_put_failure:
+	nl80211_free(req);
+	return -ENOMEM;
+}
+
+/*
+ * Only one scan can run on a phy at a time. If another one is in flight,
+ * possibly started by a different process or on another interface of the
+ * phy, its results are awaited and shared instead of failing with EBUSY.
+ * The scan is listed among the pending ones while it runs, so that its
+ * completion counts as recent.
+ */
+static int nl80211_scan_sync(const char *ifname, int phyidx,
+                             const struct lwf_scan_params *p)
+{
+	int err;
 
-		if (strstr(spec, "WEP-40"))
-			c->pair_ciphers |= LWF_CIPHER_WEP40;
+	err = nl80211_scan_trigger(ifname, p);
 
-		if (strstr(spec, "WEP-104"))
-			c->pair_ciphers |= LWF_CIPHER_WEP104;
+	if (err == -EBUSY && phyidx >= 0)
+	{
+		err = nl80211_wait_phy(phyidx, NL80211_SCAN_BUSY_WAIT,
+		                       NL80211_CMD_NEW_SCAN_RESULTS,
+		                       NL80211_CMD_SCAN_ABORTED);
 
-		c->group_ciphers = c->pair_ciphers;
+		/* the scan belongs to someone else, leave it running */
+		return (err == -ETIMEDOUT) ? -EBUSY : err;
 	}
-	else
+	else if (err)
 	{
-		c->enabled = 0;
+		return err;
+	}
+
+	switch ((err = nl80211_wait(ifname, NL80211_SCAN_TIMEOUT,
+	                            NL80211_CMD_NEW_SCAN_RESULTS,
+	                            NL80211_CMD_SCAN_ABORTED)))
+	{
+	/* do not leave the radio scanning when giving up on it */
+	case -ETIMEDOUT:
+	case -ECANCELED:
+		nl80211_abort_scan(ifname);
+		break;
 	}
+
+	return err;
 }
 
+/* Full scans reuse the results of a scan which just completed */
+static int nl80211_get_scanlist_nl(const char *ifname,
+                                   const struct lwf_scan_params *p,
+                                   struct nl80211_scan_out *out)
+{
+	struct nl80211_scan sync = { 0 }, **sp;
+	int err;
 
-struct nl80211_scanlist {
-	struct lwf_scanlist_entry *e;
-	int len;
-};
+	out->b->len = 0;
 
+	if ((err = nl80211_wait_prepare("nl80211", "scan")) != 0)
+		return err;
 
-static void nl80211_get_scanlist_ie(struct nlattr **bss,
-                                    struct lwf_scanlist_entry *e)
-{
-	int ielen = nla_len(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
-	unsigned char *ie = nla_data(bss[NL80211_BSS_INFORMATION_ELEMENTS]);
-	static unsigned char ms_oui[3] = { 0x00, 0x50, 0xf2 };
-	int len;
+	sync.ifidx = nl80211_ifindex(ifname);
+	sync.phyidx = nl80211_phyidx(ifname);
 
-	while (ielen >= 2 && ielen >= ie[1])
+	if (p || sync.phyidx < 0 || !nl80211_scan_recent(sync.phyidx))
 	{
-		switch (ie[0])
-		{
-		case 0: /* SSID */
-		case 114: /* Mesh ID */
-			if (e->ssid[0] == 0) {
-				len = min(ie[1], LWF_ESSID_MAX_SIZE);
-				memcpy(e->ssid, ie + 2, len);
-				e->ssid[len] = 0;
-			}
-			break;
+		sync.next = nls->scans;
+		nls->scans = &sync;
 
-		case 48: /* RSN */
-			lwf_parse_rsn(&e->crypto, ie + 2, ie[1],
-			                 LWF_CIPHER_CCMP, LWF_KMGMT_8021x);
-			break;
+		err = nl80211_scan_sync(ifname, sync.phyidx, p);
 
-		case 221: /* Vendor */
-			if (ie[1] >= 4 && !memcmp(ie + 2, ms_oui, 3) && ie[5] == 1)
-				lwf_parse_rsn(&e->crypto, ie + 6, ie[1] - 4,
-				                 LWF_CIPHER_TKIP, LWF_KMGMT_PSK);
-			break;
+		for (sp = &nls->scans; *sp; sp = &(*sp)->next)
+		{
+			if (*sp == &sync)
+			{
+				*sp = sync.next;
+				break;
+			}
 		}
 
-		ielen -= ie[1] + 2;
-		ie += ie[1] + 2;
+		if (err)
+			return err;
 	}
+
+	if (out->v2)
+		err = nl80211_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                      nl80211_get_scanlist_v2_cb, out);
+	else
+		err = nl80211_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                      nl80211_get_scanlist_cb, out->b);
+
+	if (err)
+		out->b->len = 0;
+
+	return err;
 }
 
-static int nl80211_get_scanlist_cb(struct nl_msg *msg, void *arg)
-{
-	int8_t rssi;
-	uint16_t caps;
+struct nl80211_scan_age {
+	struct lwf_buf *b;
+	int max_age;
+	int64_t now;
+};
 
-	struct nl80211_scanlist *sl = arg;
+/* Skip BSS entries older than max_age before parsing them into the list */
+static int nl80211_scan_age_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_scan_age *a = arg;
 	struct nlattr **tb = nl80211_parse(msg);
 	struct nlattr *bss[NL80211_BSS_MAX + 1];
+	int64_t age;
 
-	static struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
-		[NL80211_BSS_TSF]                  = { .type = NLA_U64 },
-		[NL80211_BSS_FREQUENCY]            = { .type = NLA_U32 },
-		[NL80211_BSS_BSSID]                = { 0 },
-		[NL80211_BSS_BEACON_INTERVAL]      = { .type = NLA_U16 },
-		[NL80211_BSS_CAPABILITY]           = { .type = NLA_U16 },
-		[NL80211_BSS_INFORMATION_ELEMENTS] = { 0 },
-		[NL80211_BSS_SIGNAL_MBM]           = { .type = NLA_U32 },
-		[NL80211_BSS_SIGNAL_UNSPEC]        = { .type = NLA_U8  },
-		[NL80211_BSS_STATUS]               = { .type = NLA_U32 },
+	static struct nla_policy age_policy[NL80211_BSS_MAX + 1] = {
 		[NL80211_BSS_SEEN_MS_AGO]          = { .type = NLA_U32 },
-		[NL80211_BSS_BEACON_IES]           = { 0 },
+		[NL80211_BSS_LAST_SEEN_BOOTTIME]   = { .type = NLA_U64 },
 	};
 
 	if (!tb[NL80211_ATTR_BSS] ||
-		nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS],
-		                 bss_policy) ||
-		!bss[NL80211_BSS_BSSID])
-	{
+	    nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS],
+	                     age_policy))
 		return NL_SKIP;
-	}
 
-	if (bss[NL80211_BSS_CAPABILITY])
-		caps = nla_get_u16(bss[NL80211_BSS_CAPABILITY]);
+	/* the boottime stamp is exact, the relative age lags by dump time */
+	if (bss[NL80211_BSS_LAST_SEEN_BOOTTIME])
+		age = (a->now - (int64_t)
+		       nla_get_u64(bss[NL80211_BSS_LAST_SEEN_BOOTTIME])) / 1000000;
+	else if (bss[NL80211_BSS_SEEN_MS_AGO])
+		age = nla_get_u32(bss[NL80211_BSS_SEEN_MS_AGO]);
 	else
-		caps = 0;
+		age = 0;
 
-	memset(sl->e, 0, sizeof(*sl->e));
-	memcpy(sl->e->mac, nla_data(bss[NL80211_BSS_BSSID]), 6);
+	if (age > a->max_age)
+		return NL_SKIP;
 
-	if (caps & (1<<1))
-		sl->e->mode = LWF_OPMODE_ADHOC;
-	else if (caps & (1<<0))
-		sl->e->mode = LWF_OPMODE_MASTER;
+	return nl80211_get_scanlist_cb(msg, a->b);
+}
+
+static int nl80211_get_scanlist_cached(const char *ifname, int max_age,
+                                       struct lwf_buf *b)
+{
+	struct nl80211_scan_age a = { .b = b, .max_age = max_age };
+	struct timespec ts;
+	int err;
+
+	b->len = 0;
+
+	if (max_age < 0)
+	{
+		err = nl80211_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                      nl80211_get_scanlist_cb, b);
+	}
 	else
-		sl->e->mode = LWF_OPMODE_MESHPOINT;
+	{
+		clock_gettime(CLOCK_BOOTTIME, &ts);
+		a.now = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
 
-	if (caps & (1<<4))
-		sl->e->crypto.enabled = 1;
+		err = nl80211_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                      nl80211_scan_age_cb, &a);
+	}
 
-	if (bss[NL80211_BSS_FREQUENCY])
-		sl->e->channel = nl80211_freq2channel(nla_get_u32(
-			bss[NL80211_BSS_FREQUENCY]));
+	if (err)
+		b->len = 0;
 
-	if (bss[NL80211_BSS_INFORMATION_ELEMENTS])
-		nl80211_get_scanlist_ie(bss, sl->e);
+	return err;
+}
 
-	if (bss[NL80211_BSS_SIGNAL_MBM])
-	{
-		sl->e->signal =
-			(uint8_t)((int32_t)nla_get_u32(bss[NL80211_BSS_SIGNAL_MBM]) / 100);
+struct nl80211_scan_stream {
+	void (*cb)(const struct lwf_scanlist_entry *, void *);
+	void *ctx;
+};
 
-		rssi = sl->e->signal - 0x100;
+/* Parse each BSS of the dump into a single entry and pass it on directly */
+static int nl80211_scan_stream_cb(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_scan_stream *st = arg;
+	struct lwf_scanlist_entry e;
+	struct lwf_buf b = { .buf = (char *)&e, .size = sizeof(e) };
 
-		if (rssi < -110)
-			rssi = -110;
-		else if (rssi > -40)
-			rssi = -40;
+	nl80211_get_scanlist_cb(msg, &b);
 
-		sl->e->quality = (rssi + 110);
-		sl->e->quality_max = 70;
+	if (b.len == sizeof(e))
+		st->cb(&e, st->ctx);
+
+	return NL_SKIP;
+}
+
+static void * nl80211_scan_start(const char *ifname,
+	const struct lwf_scan_params *p, int timeout,
+	void (*cb)(const struct lwf_scanlist_entry *, void *), void *ctx)
+{
+	struct nl80211_scan *s;
+	int64_t busy;
+	int err;
+
+	if (nl80211_wait_prepare("nl80211", "scan"))
+		return NULL;
+
+	if (!(s = calloc(1, sizeof(*s))))
+		return NULL;
+
+	strncpy(s->ifname, ifname, sizeof(s->ifname) - 1);
+	s->ifidx = nl80211_ifindex(ifname);
+	s->phyidx = nl80211_phyidx(ifname);
+	s->deadline = nl80211_deadline(timeout ? timeout : NL80211_SCAN_TIMEOUT);
+	s->cb = cb;
+	s->ctx = ctx;
+
+	if (s->ifidx <= 0)
+	{
+		free(s);
+		return NULL;
+	}
+
+	/* share a scan which just completed or is still running */
+	if (!p && s->phyidx >= 0 && nl80211_scan_recent(s->phyidx))
+	{
+		s->event = NL80211_CMD_NEW_SCAN_RESULTS;
 	}
+	else if ((err = nl80211_scan_trigger(ifname, p)) == -EBUSY &&
+	         s->phyidx >= 0)
+	{
+		s->busy = true;
+		busy = nl80211_deadline(NL80211_SCAN_BUSY_WAIT);
 
-	if (sl->e->crypto.enabled && !sl->e->crypto.wpa_version)
+		if (s->deadline < 0 || s->deadline > busy)
+			s->deadline = busy;
+	}
+	else if (err)
 	{
-		sl->e->crypto.auth_algs    = LWF_AUTH_OPEN | LWF_AUTH_SHARED;
-		sl->e->crypto.pair_ciphers = LWF_CIPHER_WEP40 | LWF_CIPHER_WEP104;
+		free(s);
+		return NULL;
 	}
 
-	sl->e++;
-	sl->len++;
+	s->next = nls->scans;
+	nls->scans = s;
 
-	return NL_SKIP;
+	return s;
 }
 
-static int nl80211_get_scanlist_nl(const char *ifname, char *buf, int *len)
+static int nl80211_scan_fd(void)
 {
-	struct nl80211_scanlist sl = { .e = (struct lwf_scanlist_entry *)buf };
+	if (!nls || !nls->nl_wait)
+		return -ENOENT;
 
-	if (nl80211_request(ifname, NL80211_CMD_TRIGGER_SCAN, 0, NULL, NULL))
-		goto out;
+	return nl_socket_get_fd(nls->nl_wait);
+}
 
-	if (nl80211_wait("nl80211", "scan",
-	                 NL80211_CMD_NEW_SCAN_RESULTS, NL80211_CMD_SCAN_ABORTED))
-		goto out;
+static int nl80211_scan_poll(void *handle)
+{
+	struct nl80211_scan *s = handle, *p;
+	struct nl80211_scan_stream st = { .cb = s->cb, .ctx = s->ctx };
+	struct pollfd pfd = { .events = POLLIN };
+	int err;
 
-	if (nl80211_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
-	                    nl80211_get_scanlist_cb, &sl))
-		goto out;
+	if (s->result)
+		return s->result;
 
-	*len = sl.len * sizeof(struct lwf_scanlist_entry);
-	return 0;
+	nl_cb_set(nls->nl_wait_cb, NL_CB_VALID, NL_CB_CUSTOM,
+	          nl80211_scan_event_cb, NULL);
 
-out:
-	*len = 0;
-	return -1;
+	pfd.fd = nl_socket_get_fd(nls->nl_wait);
+
+	while (poll(&pfd, 1, 0) > 0)
+	{
+		err = nl_recvmsgs(nls->nl_wait, nls->nl_wait_cb);
+
+		/* events were lost, collect whatever the kernel has by now */
+		if (err < 0 && err != -NLE_AGAIN)
+		{
+			for (p = nls->scans; p; p = p->next)
+				if (!p->event)
+					p->event = NL80211_CMD_NEW_SCAN_RESULTS;
+
+			break;
+		}
+	}
+
+	switch (s->event)
+	{
+	case NL80211_CMD_NEW_SCAN_RESULTS:
+		err = nl80211_request(s->ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                      nl80211_scan_stream_cb, &st);
+		s->result = err ? err : 1;
+		break;
+
+	case NL80211_CMD_SCAN_ABORTED:
+		s->result = -ECONNABORTED;
+		break;
+
+	default:
+		if (s->deadline >= 0 && nl80211_now() >= s->deadline)
+		{
+			if (!s->busy)
+				nl80211_abort_scan(s->ifname);
+
+			s->result = s->busy ? -EBUSY : -ETIMEDOUT;
+		}
+		break;
+	}
+
+	return s->result;
+}
+
+/* Dropping a scan which is still running aborts it, unless it was shared */
+static void nl80211_scan_free(void *handle)
+{
+	struct nl80211_scan *s = handle, **p;
+
+	for (p = &nls->scans; *p; p = &(*p)->next)
+	{
+		if (*p == s)
+		{
+			*p = s->next;
+			break;
+		}
+	}
+
+	if (!s->result && !s->event && !s->busy)
+		nl80211_abort_scan(s->ifname);
+
+	free(s);
 }
 
 static int wpasupp_ssid_decode(const char *in, char *out, int outlen)
@@ -2263,12 +5093,12 @@ static int wpasupp_ssid_decode(const char *in, char *out, int outlen)
 	return len;
 }
 
-static int nl80211_get_scanlist_wpactl(const char *ifname, char *buf, int *len)
+static int nl80211_get_scanlist_wpactl(const char *ifname, struct lwf_buf *b)
 {
 	int sock, qmax, rssi, tries, count = -1, ready = 0;
 	char *pos, *line, *bssid, *freq, *signal, *flags, *ssid, reply[4096];
 	struct sockaddr_un local = { 0 };
-	struct lwf_scanlist_entry *e = (struct lwf_scanlist_entry *)buf;
+	struct lwf_scanlist_entry *e;
 
 	sock = nl80211_wpactl_connect(ifname, &local);
 
@@ -2341,6 +5171,13 @@ static int nl80211_get_scanlist_wpactl(const char *ifname, char *buf, int *len)
 			if (!bssid || !freq || !signal || !flags || !ssid)
 				continue;
 
+			count++;
+
+			if (!(e = lwf_buf_add(b, sizeof(*e))))
+				continue;
+
+			memset(e, 0, sizeof(*e));
+
 			/* BSSID */
 			e->mac[0] = strtol(&bssid[0],  NULL, 16);
 			e->mac[1] = strtol(&bssid[3],  NULL, 16);
@@ -2390,12 +5227,8 @@ static int nl80211_get_scanlist_wpactl(const char *ifname, char *buf, int *len)
 
 			/* Crypto */
 			nl80211_get_scancrypto(flags, &e->crypto);
-
-			count++;
-			e++;
 		}
 
-		*len = count * sizeof(struct lwf_scanlist_entry);
 		break;
 	}
 
@@ -2405,12 +5238,14 @@ static int nl80211_get_scanlist_wpactl(const char *ifname, char *buf, int *len)
 	return (count >= 0) ? 0 : -1;
 }
 
-static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
+static int nl80211_list_scan_out(const char *ifname,
+                                 const struct lwf_scan_params *p,
+                                 struct nl80211_scan_out *out)
 {
 	char *res;
 	int rv, mode;
 
-	*len = 0;
+	out->b->len = 0;
 
 	/* Got a radioX pseudo interface, find some interface on it or create one */
 	if (!strncmp(ifname, "radio", 5))
@@ -2418,33 +5253,32 @@ static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
 		/* Reuse existing interface */
 		if ((res = nl80211_phy2ifname(ifname)) != NULL)
 		{
-			return nl80211_get_scanlist(res, buf, len);
+			return nl80211_list_scan_out(res, p, out);
 		}
 
 		/* Need to spawn a temporary iface for scanning */
 		else if ((res = nl80211_ifadd(ifname)) != NULL)
 		{
-			rv = nl80211_get_scanlist(res, buf, len);
+			rv = nl80211_list_scan_out(res, p, out);
 			nl80211_ifdel(res);
 			return rv;
 		}
 	}
 
-	/* WPA supplicant */
-	if (!nl80211_get_scanlist_wpactl(ifname, buf, len))
+	/* WPA supplicant, which can not pass on scan parameters or elements */
+	if (!p && !out->v2 && !nl80211_get_scanlist_wpactl(ifname, out->b))
 	{
 		return 0;
 	}
 
-	/* station / ad-hoc / monitor scan */
+	/* station / ad-hoc / monitor scan, APs scan below */
 	else if (!nl80211_get_mode(ifname, &mode) &&
 	         (mode == LWF_OPMODE_ADHOC ||
-	          mode == LWF_OPMODE_MASTER ||
 	          mode == LWF_OPMODE_CLIENT ||
 	          mode == LWF_OPMODE_MONITOR) &&
 	         lwf_ifup(ifname))
 	{
-		return nl80211_get_scanlist_nl(ifname, buf, len);
+		return nl80211_get_scanlist_nl(ifname, p, out);
 	}
 
 	/* AP scan */
@@ -2456,24 +5290,31 @@ static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
 			if (!lwf_ifup(ifname))
 				return -1;
 
-			rv = nl80211_get_scanlist_nl(ifname, buf, len);
+			rv = nl80211_get_scanlist_nl(ifname, p, out);
 			lwf_ifdown(ifname);
 			return rv;
 		}
 
-		/* Spawn a new scan interface */
+		/* Scan off-channel from the AP itself, clients stay connected */
+		else if (nl80211_ap_scan(ifname) &&
+		         !(rv = nl80211_get_scanlist_nl(ifname, p, out)))
+		{
+			return 0;
+		}
+
+		/* Reuse the scan interface of the phy or create it once */
 		else
 		{
-			if (!(res = nl80211_ifadd(ifname)))
+			if (!(res = nl80211_scan_vif(ifname)))
 				return -1;
 
-			lwf_ifmac(res);
+			rv = -1;
 
 			/* if we can take the new interface up, the driver supports an
 			 * additional interface and there's no need to tear down the ap */
 			if (lwf_ifup(res))
 			{
-				rv = nl80211_get_scanlist_nl(res, buf, len);
+				rv = nl80211_get_scanlist_nl(res, p, out);
 				lwf_ifdown(res);
 			}
 
@@ -2481,13 +5322,12 @@ static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
 			 * during scan */
 			else if (lwf_ifdown(ifname) && lwf_ifup(res))
 			{
-				rv = nl80211_get_scanlist_nl(res, buf, len);
+				rv = nl80211_get_scanlist_nl(res, p, out);
 				lwf_ifdown(res);
 				lwf_ifup(ifname);
 				nl80211_hostapd_hup(ifname);
 			}
 
-			nl80211_ifdel(res);
 			return rv;
 		}
 	}
@@ -2495,92 +5335,48 @@ static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
 	return -1;
 }
 
-static int nl80211_get_freqlist_cb(struct nl_msg *msg, void *arg)
+static int nl80211_list_scan(const char *ifname,
+                             const struct lwf_scan_params *p,
+                             struct lwf_buf *b)
 {
-	int bands_remain, freqs_remain;
-
-	struct nl80211_array_buf *arr = arg;
-	struct lwf_freqlist_entry *e;
+	struct nl80211_scan_out out = { .b = b };
 
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *bands[NL80211_BAND_ATTR_MAX + 1];
-	struct nlattr *freqs[NL80211_FREQUENCY_ATTR_MAX + 1];
-	struct nlattr *band, *freq;
-
-	e = arr->buf;
-	e += arr->count;
-
-	if (attr[NL80211_ATTR_WIPHY_BANDS]) {
-		nla_for_each_nested(band, attr[NL80211_ATTR_WIPHY_BANDS], bands_remain)
-		{
-			nla_parse(bands, NL80211_BAND_ATTR_MAX,
-				  nla_data(band), nla_len(band), NULL);
+	return nl80211_list_scan_out(ifname, p, &out);
+}
 
-			if (bands[NL80211_BAND_ATTR_FREQS]) {
-				nla_for_each_nested(freq, bands[NL80211_BAND_ATTR_FREQS], freqs_remain)
-				{
-					nla_parse(freqs, NL80211_FREQUENCY_ATTR_MAX,
-						  nla_data(freq), nla_len(freq), NULL);
-
-					if (!freqs[NL80211_FREQUENCY_ATTR_FREQ] ||
-					    freqs[NL80211_FREQUENCY_ATTR_DISABLED])
-						continue;
-
-					e->mhz = nla_get_u32(freqs[NL80211_FREQUENCY_ATTR_FREQ]);
-					e->channel = nl80211_freq2channel(e->mhz);
-
-					e->restricted = (
-						freqs[NL80211_FREQUENCY_ATTR_NO_IR] &&
-						!freqs[NL80211_FREQUENCY_ATTR_RADAR]
-					) ? 1 : 0;
-
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_HT40_MINUS])
-						e->flags |= LWF_FREQ_NO_HT40MINUS;
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_HT40_PLUS])
-						e->flags |= LWF_FREQ_NO_HT40PLUS;
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_80MHZ])
-						e->flags |= LWF_FREQ_NO_80MHZ;
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_160MHZ])
-						e->flags |= LWF_FREQ_NO_160MHZ;
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_20MHZ])
-						e->flags |= LWF_FREQ_NO_20MHZ;
-					if (freqs[NL80211_FREQUENCY_ATTR_NO_10MHZ])
-						e->flags |= LWF_FREQ_NO_10MHZ;
-
-					e++;
-					arr->count++;
-				}
-			}
-		}
-	}
+static int nl80211_get_scanlist_v2(const char *ifname,
+                                   const struct lwf_scan_params *p,
+                                   uint32_t info, struct lwf_buf *b)
+{
+	struct nl80211_scan_out out = { .b = b, .info = info, .v2 = true };
 
-	return NL_SKIP;
+	return nl80211_list_scan_out(ifname, p, &out);
 }
 
-static int nl80211_get_freqlist(const char *ifname, char *buf, int *len)
+static int nl80211_list_freq(const char *ifname, struct lwf_buf *b)
 {
-	struct nl80211_msg_conveyor *cv;
-	struct nl80211_array_buf arr = { .buf = buf, .count = 0 };
-	uint32_t features = nl80211_get_protocol_features(ifname);
-	int flags;
+	int i;
+	struct nl80211_wiphy_info *info;
+	struct lwf_freqlist_entry *e;
 
-	flags = features & NL80211_PROTOCOL_FEATURE_SPLIT_WIPHY_DUMP ? NLM_F_DUMP : 0;
-	cv = nl80211_msg(ifname, NL80211_CMD_GET_WIPHY, flags);
-	if (!cv)
-		goto out;
+	if (!(info = nl80211_wiphy_get(ifname)))
+		return -1;
 
-	NLA_PUT_FLAG(cv->msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
-	if (nl80211_send(cv, nl80211_get_freqlist_cb, &arr))
-		goto out;
+	for (i = 0; i < info->freqs_count; i++)
+	{
+		if (info->freqs[i].disabled)
+			continue;
 
-	*len = arr.count * sizeof(struct lwf_freqlist_entry);
-	return 0;
+		if (!(e = lwf_buf_add(b, sizeof(*e))))
+			continue;
 
-nla_put_failure:
-	nl80211_free(cv);
-out:
-	*len = 0;
-	return -1;
+		e->mhz = info->freqs[i].mhz;
+		e->channel = nl80211_freq2channel(e->mhz);
+		e->restricted = info->freqs[i].restricted;
+		e->flags = info->freqs[i].flags;
+	}
+
+	return 0;
 }
 
 static int nl80211_get_country_cb(struct nl_msg *msg, void *arg)
@@ -2593,221 +5389,296 @@ static int nl80211_get_country_cb(struct nl_msg *msg, void *arg)
 	else
 		buf[0] = 0;
 
-	return NL_SKIP;
-}
+	return NL_SKIP;
+}
+
+static int nl80211_get_country(const char *ifname, char *buf)
+{
+	if (nl80211_request(ifname, NL80211_CMD_GET_REG, 0,
+	                    nl80211_get_country_cb, buf))
+		return -1;
+
+	return 0;
+}
+
+static int nl80211_list_country(const char *ifname, struct lwf_buf *b)
+{
+	struct lwf_country_entry *e;
+	const struct lwf_iso3166_label *l;
+
+	for (l = LWF_ISO3166_NAMES; l->iso3166; l++)
+	{
+		if (!(e = lwf_buf_add(b, sizeof(*e))))
+			continue;
+
+		e->iso3166 = l->iso3166;
+		e->ccode[0] = (l->iso3166 / 256);
+		e->ccode[1] = (l->iso3166 % 256);
+		e->ccode[2] = 0;
+	}
+
+	return 0;
+}
+
+static int nl80211_get_list(const char *ifname, enum lwf_list_type type,
+                            struct lwf_buf *b)
+{
+	int rv;
+
+	b->len = 0;
+
+	switch (type)
+	{
+	case LWF_LIST_ASSOC:
+		rv = nl80211_list_assoc(ifname, b);
+		break;
+
+	case LWF_LIST_SCAN:
+		rv = nl80211_list_scan(ifname, NULL, b);
+		break;
+
+	case LWF_LIST_FREQ:
+		rv = nl80211_list_freq(ifname, b);
+		break;
+
+	case LWF_LIST_SURVEY:
+		rv = nl80211_list_survey(ifname, b);
+		break;
+
+	case LWF_LIST_TXPWR:
+		rv = nl80211_list_txpwr(ifname, b);
+		break;
+
+	case LWF_LIST_COUNTRY:
+		rv = nl80211_list_country(ifname, b);
+		break;
+
+	case LWF_LIST_ASSOC_WATCHED:
+		rv = nl80211_list_watched(ifname, b);
+		break;
+
+	default:
+		return -EINVAL;
+	}
 
-static int nl80211_get_country(const char *ifname, char *buf)
-{
-	if (nl80211_request(ifname, NL80211_CMD_GET_REG, 0,
-	                    nl80211_get_country_cb, buf))
-		return -1;
+	if (!rv && b->len > b->size)
+		rv = -ENOSPC;
 
-	return 0;
+	return rv;
 }
 
-static int nl80211_get_countrylist(const char *ifname, char *buf, int *len)
+/*
+ * The legacy list ops write into a caller supplied LWF_BUFSIZE buffer, any
+ * entries which do not fit are dropped instead of overrunning it.
+ */
+static int nl80211_get_list_fixed(const char *ifname, enum lwf_list_type type,
+                                  int esize, char *buf, int *len)
 {
-	int count;
-	struct lwf_country_entry *e = (struct lwf_country_entry *)buf;
-	const struct lwf_iso3166_label *l;
+	struct lwf_buf b = { .buf = buf, .size = LWF_BUFSIZE };
+	int rv = nl80211_get_list(ifname, type, &b);
 
-	for (l = LWF_ISO3166_NAMES, count = 0; l->iso3166; l++, e++, count++)
+	if (rv == -ENOSPC)
 	{
-		e->iso3166 = l->iso3166;
-		e->ccode[0] = (l->iso3166 / 256);
-		e->ccode[1] = (l->iso3166 % 256);
-		e->ccode[2] = 0;
+		*len = b.size - (b.size % esize);
+		return 0;
 	}
 
-	*len = (count * sizeof(struct lwf_country_entry));
-	return 0;
+	*len = rv ? 0 : b.len;
+	return rv;
 }
 
-
-struct nl80211_modes
-{
-	bool ok;
-	uint32_t hw;
-	uint32_t ht;
+struct nl80211_async_list {
+	enum lwf_list_type type;
+	struct lwf_buf *b;
+	int pending;
+	int err;
+	int8_t noise;
+	void (*done)(int, struct lwf_buf *, void *);
+	void *ctx;
 };
 
-static int nl80211_get_modelist_cb(struct nl_msg *msg, void *arg)
+static void nl80211_async_list_done(int err, void *arg)
 {
-	struct nl80211_modes *m = arg;
-	int bands_remain, freqs_remain;
-	uint16_t caps = 0;
-	uint32_t vht_caps = 0;
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *bands[NL80211_BAND_ATTR_MAX + 1];
-	struct nlattr *freqs[NL80211_FREQUENCY_ATTR_MAX + 1];
-	struct nlattr *band, *freq;
+	struct nl80211_async_list *l = arg;
+	struct lwf_assoclist_entry *e;
+	int i, n, len;
 
-	if (attr[NL80211_ATTR_WIPHY_BANDS])
-	{
-		nla_for_each_nested(band, attr[NL80211_ATTR_WIPHY_BANDS], bands_remain)
-		{
-			nla_parse(bands, NL80211_BAND_ATTR_MAX,
-			          nla_data(band), nla_len(band), NULL);
+	/* like the synchronous variants, only scan dump errors are fatal */
+	if (err && l->type == LWF_LIST_SCAN && !l->err)
+		l->err = err;
 
-			if (bands[NL80211_BAND_ATTR_HT_CAPA])
-				caps = nla_get_u16(bands[NL80211_BAND_ATTR_HT_CAPA]);
+	if (--l->pending > 0)
+		return;
 
-			/* Treat any nonzero capability as 11n */
-			if (caps > 0)
-			{
-				m->hw |= LWF_80211_N;
-				m->ht |= LWF_HTMODE_HT20;
+	if (l->type == LWF_LIST_ASSOC)
+	{
+		len = (l->b->len < l->b->size) ? l->b->len : l->b->size;
+		n = len / sizeof(*e);
 
-				if (caps & (1 << 1))
-					m->ht |= LWF_HTMODE_HT40;
-			}
+		for (i = 0, e = (struct lwf_assoclist_entry *)l->b->buf; i < n; i++, e++)
+			e->noise = l->noise;
+	}
 
-			nla_for_each_nested(freq, bands[NL80211_BAND_ATTR_FREQS],
-			                    freqs_remain)
-			{
-				nla_parse(freqs, NL80211_FREQUENCY_ATTR_MAX,
-				          nla_data(freq), nla_len(freq), NULL);
+	if (l->err)
+		l->b->len = 0;
+	else if (l->b->len > l->b->size)
+		l->err = -ENOSPC;
 
-				if (!freqs[NL80211_FREQUENCY_ATTR_FREQ])
-					continue;
+	l->done(l->err, l->b, l->ctx);
+	free(l);
+}
 
-				if (nla_get_u32(freqs[NL80211_FREQUENCY_ATTR_FREQ]) < 2485)
-				{
-					m->hw |= LWF_80211_B;
-					m->hw |= LWF_80211_G;
-				}
-				else if (bands[NL80211_BAND_ATTR_VHT_CAPA])
-				{
-					vht_caps = nla_get_u32(bands[NL80211_BAND_ATTR_VHT_CAPA]);
+static int nl80211_async_list(const char *ifname, enum lwf_list_type type,
+                              struct lwf_buf *b,
+                              void (*done)(int, struct lwf_buf *, void *),
+                              void *ctx)
+{
+	DIR *d;
+	struct dirent *de;
+	struct nl80211_async_list *l;
+	int err;
 
-					/* Treat any nonzero capability as 11ac */
-					if (vht_caps > 0)
-					{
-						m->hw |= LWF_80211_AC;
-						m->ht |= LWF_HTMODE_VHT20 | LWF_HTMODE_VHT40 | LWF_HTMODE_VHT80;
-
-						switch ((vht_caps >> 2) & 3)
-						{
-						case 2:
-							m->ht |= LWF_HTMODE_VHT80_80;
-							/* fall through */
-
-						case 1:
-							m->ht |= LWF_HTMODE_VHT160;
-						}
-					}
-				}
-				else if (!(m->hw & LWF_80211_AC))
-				{
-					m->hw |= LWF_80211_A;
-				}
-			}
-		}
+	switch (type)
+	{
+	case LWF_LIST_ASSOC:
+	case LWF_LIST_SURVEY:
+	case LWF_LIST_SCAN:
+		break;
 
-		m->ok = 1;
+	/* served from caches, nothing to wait for */
+	default:
+		err = nl80211_get_list(ifname, type, b);
+		done(err, b, ctx);
+		return 0;
 	}
 
-	return NL_SKIP;
-}
-
-static int nl80211_get_hwmodelist(const char *ifname, int *buf)
-{
-	struct nl80211_modes m = { 0 };
-
-	if (nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
-	                    nl80211_get_modelist_cb, &m))
-		goto out;
+	if (!(l = calloc(1, sizeof(*l))))
+		return -ENOMEM;
 
-	if (!m.ok)
-		goto out;
+	l->type = type;
+	l->b = b;
+	l->done = done;
+	l->ctx = ctx;
 
-	*buf = m.hw;
-	return 0;
+	b->len = 0;
 
-out:
-	*buf = 0;
-	return -1;
-}
+	/* hold a reference while submitting, so nothing completes early */
+	l->pending = 1;
 
-static int nl80211_get_htmodelist(const char *ifname, int *buf)
-{
-	struct nl80211_modes m = { 0 };
+	if (type == LWF_LIST_SURVEY)
+	{
+		if (!nl80211_async_request(ifname, NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
+		                           nl80211_get_survey_cb, b,
+		                           nl80211_async_list_done, l))
+			l->pending++;
+	}
+	else if (type == LWF_LIST_SCAN)
+	{
+		if (!nl80211_async_request(ifname, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
+		                           nl80211_get_scanlist_cb, b,
+		                           nl80211_async_list_done, l))
+			l->pending++;
+		else
+			l->err = -ENOLINK;
+	}
+	else if ((d = opendir("/sys/class/net")) != NULL)
+	{
+		if (!nl80211_async_request(ifname, NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
+		                           nl80211_get_noise_cb, &l->noise,
+		                           nl80211_async_list_done, l))
+			l->pending++;
 
-	if (nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
-	                    nl80211_get_modelist_cb, &m))
-		goto out;
+		while ((de = readdir(d)) != NULL)
+		{
+			if (!strncmp(de->d_name, ifname, strlen(ifname)) &&
+			    (!de->d_name[strlen(ifname)] ||
+			     !strncmp(&de->d_name[strlen(ifname)], ".sta", 4)) &&
+			    !nl80211_async_request(de->d_name, NL80211_CMD_GET_STATION,
+			                           NLM_F_DUMP, nl80211_get_assoclist_cb, b,
+			                           nl80211_async_list_done, l))
+				l->pending++;
+		}
 
-	if (!m.ok)
-		goto out;
+		closedir(d);
+	}
 
-	*buf = m.ht;
+	nl80211_async_list_done(0, l);
 	return 0;
+}
 
-out:
-	*buf = 0;
-	return -1;
+static int nl80211_get_assoclist(const char *ifname, char *buf, int *len)
+{
+	return nl80211_get_list_fixed(ifname, LWF_LIST_ASSOC,
+	                              sizeof(struct lwf_assoclist_entry), buf, len);
 }
 
+static int nl80211_get_scanlist(const char *ifname, char *buf, int *len)
+{
+	return nl80211_get_list_fixed(ifname, LWF_LIST_SCAN,
+	                              sizeof(struct lwf_scanlist_entry), buf, len);
+}
 
-static int nl80211_get_ifcomb_cb(struct nl_msg *msg, void *arg)
+static int nl80211_get_freqlist(const char *ifname, char *buf, int *len)
 {
-	struct nlattr **attr = nl80211_parse(msg);
-	struct nlattr *comb;
-	int *ret = arg;
-	int comb_rem, limit_rem, mode_rem;
+	return nl80211_get_list_fixed(ifname, LWF_LIST_FREQ,
+	                              sizeof(struct lwf_freqlist_entry), buf, len);
+}
 
-	*ret = 0;
-	if (!attr[NL80211_ATTR_INTERFACE_COMBINATIONS])
-		return NL_SKIP;
+static int nl80211_get_survey(const char *ifname, char *buf, int *len)
+{
+	return nl80211_get_list_fixed(ifname, LWF_LIST_SURVEY,
+	                              sizeof(struct lwf_survey_entry), buf, len);
+}
 
-	nla_for_each_nested(comb, attr[NL80211_ATTR_INTERFACE_COMBINATIONS], comb_rem)
-	{
-		static struct nla_policy iface_combination_policy[NUM_NL80211_IFACE_COMB] = {
-			[NL80211_IFACE_COMB_LIMITS] = { .type = NLA_NESTED },
-			[NL80211_IFACE_COMB_MAXNUM] = { .type = NLA_U32 },
-		};
-		struct nlattr *tb_comb[NUM_NL80211_IFACE_COMB+1];
-		static struct nla_policy iface_limit_policy[NUM_NL80211_IFACE_LIMIT] = {
-			[NL80211_IFACE_LIMIT_TYPES] = { .type = NLA_NESTED },
-			[NL80211_IFACE_LIMIT_MAX] = { .type = NLA_U32 },
-		};
-		struct nlattr *tb_limit[NUM_NL80211_IFACE_LIMIT+1];
-		struct nlattr *limit;
+static int nl80211_get_txpwrlist(const char *ifname, char *buf, int *len)
+{
+	return nl80211_get_list_fixed(ifname, LWF_LIST_TXPWR,
+	                              sizeof(struct lwf_txpwrlist_entry), buf, len);
+}
 
-		nla_parse_nested(tb_comb, NUM_NL80211_IFACE_COMB, comb, iface_combination_policy);
+static int nl80211_get_countrylist(const char *ifname, char *buf, int *len)
+{
+	return nl80211_get_list_fixed(ifname, LWF_LIST_COUNTRY,
+	                              sizeof(struct lwf_country_entry), buf, len);
+}
 
-		if (!tb_comb[NL80211_IFACE_COMB_LIMITS])
-			continue;
 
-		nla_for_each_nested(limit, tb_comb[NL80211_IFACE_COMB_LIMITS], limit_rem)
-		{
-			struct nlattr *mode;
+static int nl80211_get_hwmodelist(const char *ifname, int *buf)
+{
+	struct nl80211_wiphy_info *info = nl80211_wiphy_get(ifname);
 
-			nla_parse_nested(tb_limit, NUM_NL80211_IFACE_LIMIT, limit, iface_limit_policy);
+	if (!info)
+	{
+		*buf = 0;
+		return -1;
+	}
 
-			if (!tb_limit[NL80211_IFACE_LIMIT_TYPES] ||
-			    !tb_limit[NL80211_IFACE_LIMIT_MAX])
-				continue;
+	*buf = info->hwmodes;
+	return 0;
+}
 
-			if (nla_get_u32(tb_limit[NL80211_IFACE_LIMIT_MAX]) < 2)
-				continue;
+static int nl80211_get_htmodelist(const char *ifname, int *buf)
+{
+	struct nl80211_wiphy_info *info = nl80211_wiphy_get(ifname);
 
-			nla_for_each_nested(mode, tb_limit[NL80211_IFACE_LIMIT_TYPES], mode_rem) {
-				if (nla_type(mode) == NL80211_IFTYPE_AP)
-					*ret = 1;
-			}
-		}
+	if (!info)
+	{
+		*buf = 0;
+		return -1;
 	}
 
-	return NL_SKIP;
+	*buf = info->htmodes;
+	return 0;
 }
 
 static int nl80211_get_mbssid_support(const char *ifname, int *buf)
 {
-	if (nl80211_request(ifname, NL80211_CMD_GET_WIPHY, 0,
-	                    nl80211_get_ifcomb_cb, buf))
+	struct nl80211_wiphy_info *info = nl80211_wiphy_get(ifname);
+
+	if (!info)
 		return -1;
 
+	*buf = info->mbssid;
 	return 0;
 }
 
@@ -2815,7 +5686,7 @@ static int nl80211_get_mbssid_support(const char *ifname, int *buf)
 static char * wext_sysfs_ifname_file(const char *ifname, const char *path)
 {
 	FILE *f;
-	static char buf[128];
+	static __thread char buf[128];
 	char *rv = NULL;
 
 	snprintf(buf, sizeof(buf), "/sys/class/net/%s/%s", ifname, path);
@@ -2860,7 +5731,7 @@ static int wext_get_hardware_id(const char *ifname, char *buf)
 }
 
 
-static int nl80211_get_hardware_id(const char *ifname, char *buf)
+static int nl80211_get_hardware_id_uncached(const char *ifname, char *buf)
 {
 	int rv = -1;
 	char *res;
@@ -2895,15 +5766,68 @@ static int nl80211_get_hardware_id(const char *ifname, char *buf)
 	return rv;
 }
 
+/*
+ * Hardware ids and database entries are memoised per interface name, the
+ * interface index is kept to notice when a netdev got recreated.
+ */
+
+static struct nl80211_hw_node * nl80211_get_hardware_node(const char *ifname)
+{
+	struct nl80211_hw_node *n;
+	unsigned int idx = nl80211_ifindex(ifname);
+
+	for (n = nl80211_hwcache; n; n = n->next)
+		if (!strcmp(n->ifname, ifname))
+			break;
+
+	if (n && n->ifindex == idx)
+		return n;
+
+	if (!n)
+	{
+		if (!(n = calloc(1, sizeof(*n))))
+			return NULL;
+
+		strncpy(n->ifname, ifname, sizeof(n->ifname) - 1);
+		n->next = nl80211_hwcache;
+		nl80211_hwcache = n;
+	}
+
+	n->ifindex = idx;
+	n->err = nl80211_get_hardware_id_uncached(ifname, (char *)&n->id);
+	n->entry = n->err ? NULL : lwf_hardware(&n->id);
+
+	return n;
+}
+
+static void nl80211_hwcache_free(void)
+{
+	struct nl80211_hw_node *n;
+
+	while ((n = nl80211_hwcache) != NULL)
+	{
+		nl80211_hwcache = n->next;
+		free(n);
+	}
+}
+
+static int nl80211_get_hardware_id(const char *ifname, char *buf)
+{
+	struct nl80211_hw_node *n = nl80211_get_hardware_node(ifname);
+
+	if (!n)
+		return nl80211_get_hardware_id_uncached(ifname, buf);
+
+	memcpy(buf, &n->id, sizeof(n->id));
+	return n->err;
+}
+
 static const struct lwf_hardware_entry *
 nl80211_get_hardware_entry(const char *ifname)
 {
-	struct lwf_hardware_id id;
+	struct nl80211_hw_node *n = nl80211_get_hardware_node(ifname);
 
-	if (nl80211_get_hardware_id(ifname, (char *)&id))
-		return NULL;
-
-	return lwf_hardware(&id);
+	return n ? n->entry : NULL;
 }
 
 static int nl80211_get_hardware_name(const char *ifname, char *buf)
@@ -2940,6 +5864,171 @@ static int nl80211_get_frequency_offset(const char *ifname, int *buf)
 	return 0;
 }
 
+static int nl80211_get_snapshot_cb(struct nl_msg *msg, void *arg)
+{
+	struct lwf_iface_snapshot *s = arg;
+	struct nlattr **tb = nl80211_parse(msg);
+	unsigned char *mac;
+	int len;
+
+	if (tb[NL80211_ATTR_IFTYPE])
+		s->mode = nl80211_iftype2mode(nla_get_u32(tb[NL80211_ATTR_IFTYPE]));
+
+	if (tb[NL80211_ATTR_WIPHY_FREQ])
+		s->frequency = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ]);
+
+	if (tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL])
+		s->txpower = lwf_mbm2dbm(nla_get_u32(tb[NL80211_ATTR_WIPHY_TX_POWER_LEVEL]));
+
+	if (tb[NL80211_ATTR_MAC])
+	{
+		mac = nla_data(tb[NL80211_ATTR_MAC]);
+		sprintf(s->bssid, "%02X:%02X:%02X:%02X:%02X:%02X",
+		        mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+	}
+
+	if (tb[NL80211_ATTR_SSID])
+	{
+		len = min(nla_len(tb[NL80211_ATTR_SSID]), LWF_ESSID_MAX_SIZE);
+		memcpy(s->ssid, nla_data(tb[NL80211_ATTR_SSID]), len);
+		s->ssid[len] = 0;
+	}
+
+	return NL_SKIP;
+}
+
+struct nl80211_snapshot_req {
+	const char *ifname;
+	struct lwf_iface_snapshot *s;
+	struct nl80211_sta_summary sum;
+	int8_t noise;
+};
+
+static void nl80211_snapshot_submit(struct nl80211_batch *b,
+                                    struct nl80211_snapshot_req *r)
+{
+	DIR *d;
+	struct dirent *de;
+	struct lwf_iface_snapshot *s = r->s;
+	const char *ifname = r->ifname;
+	char *res;
+
+	memset(s, 0, sizeof(*s));
+	memset(&r->sum, 0, sizeof(r->sum));
+	r->sum.signals.grow = 1;
+	r->noise = 0;
+
+	s->mode        = LWF_OPMODE_UNKNOWN;
+	s->channel     = -1;
+	s->frequency   = -1;
+	s->txpower     = -1;
+	s->bitrate     = -1;
+	s->quality     = -1;
+
+	res = nl80211_phy2ifname(ifname);
+
+	nl80211_batch_add(b, res ? res : ifname, NL80211_CMD_GET_INTERFACE, 0,
+	                  nl80211_get_snapshot_cb, s);
+
+	if ((d = opendir("/sys/class/net")) != NULL)
+	{
+		while ((de = readdir(d)) != NULL)
+		{
+			if (!strncmp(de->d_name, ifname, strlen(ifname)) &&
+			    (!de->d_name[strlen(ifname)] ||
+			     !strncmp(&de->d_name[strlen(ifname)], ".sta", 4)))
+			{
+				nl80211_batch_add(b, de->d_name, NL80211_CMD_GET_STATION,
+				                  NLM_F_DUMP, nl80211_summary_cb, &r->sum);
+			}
+		}
+
+		closedir(d);
+	}
+
+	nl80211_batch_add(b, ifname, NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
+	                  nl80211_get_noise_cb, &r->noise);
+}
+
+static void nl80211_snapshot_finish(struct nl80211_snapshot_req *r)
+{
+	struct lwf_iface_snapshot *s = r->s;
+	const char *ifname = r->ifname;
+
+	/* the slower hostapd and scan based lookups only fill in the gaps */
+	if (s->frequency <= 0 && nl80211_get_frequency(ifname, &s->frequency))
+		s->frequency = -1;
+
+	if (s->frequency > 0)
+		s->channel = nl80211_freq2channel(s->frequency);
+
+	if (!s->ssid[0] && nl80211_get_ssid(ifname, s->ssid))
+		s->ssid[0] = 0;
+
+	if (!s->bssid[0] && nl80211_get_bssid(ifname, s->bssid))
+		s->bssid[0] = 0;
+
+	nl80211_summary_finish(&r->sum);
+	nl80211_summary_store(ifname, &r->sum.s);
+
+	if (r->sum.s.signal_count)
+	{
+		s->signal = r->sum.s.signal_mean;
+		s->quality = nl80211_signal2quality(r->sum.s.signal_mean);
+	}
+
+	if (r->sum.s.tx_rate_mean)
+		s->bitrate = r->sum.s.tx_rate_mean;
+
+	s->noise = r->noise;
+
+	nl80211_get_quality_max(ifname, &s->quality_max);
+}
+
+/*
+ * Collect the common interface properties of several interfaces in one
+ * batch on the async socket. The GET_INTERFACE requests of all interfaces
+ * are sent at once, while the station and survey dumps follow each other
+ * since the kernel runs only one dump per socket at a time.
+ */
+static int nl80211_get_snapshots(const char **ifnames, int count,
+                                 struct lwf_iface_snapshot *s)
+{
+	struct nl80211_batch b = { 0 };
+	struct nl80211_snapshot_req *r;
+	int i, err;
+
+	if (!(r = calloc(count, sizeof(*r))))
+		return -ENOMEM;
+
+	for (i = 0; i < count; i++)
+	{
+		r[i].ifname = ifnames[i];
+		r[i].s = &s[i];
+		nl80211_snapshot_submit(&b, &r[i]);
+	}
+
+	err = nl80211_batch_run(&b);
+	nl80211_batch_free(&b);
+
+	/* a timed out batch leaves the snapshots half filled */
+	for (i = 0; i < count; i++)
+	{
+		if (err)
+			lwf_buf_free(&r[i].sum.signals);
+		else
+			nl80211_snapshot_finish(&r[i]);
+	}
+
+	free(r);
+	return err;
+}
+
+static int nl80211_get_snapshot(const char *ifname, struct lwf_iface_snapshot *s)
+{
+	return nl80211_get_snapshots(&ifname, 1, s);
+}
+
 static int nl80211_lookup_phyname(const char *section, char *buf)
 {
 	int idx;
@@ -2979,5 +6068,24 @@ const struct lwf_ops nl80211_ops = {
 	.countrylist      = nl80211_get_countrylist,
 	.survey           = nl80211_get_survey,
 	.lookup_phy       = nl80211_lookup_phyname,
+	.snapshot         = nl80211_get_snapshot,
+	.snapshots        = nl80211_get_snapshots,
+	.list             = nl80211_get_list,
+	.scanlist_cached  = nl80211_get_scanlist_cached,
+	.scanlist_params  = nl80211_list_scan,
+	.scanlist_v2      = nl80211_get_scanlist_v2,
+	.station_foreach  = nl80211_station_foreach,
+	.station_get      = nl80211_station_get,
+	.station_summary  = nl80211_get_station_summary,
+	.station_watch    = nl80211_station_watch,
+	.station_unwatch  = nl80211_station_unwatch,
+	.dispatch         = nl80211_dispatch,
+	.async_fd         = nl80211_async_fd,
+	.async_list       = nl80211_async_list,
+	.async_process    = nl80211_async_process,
+	.scan_start       = nl80211_scan_start,
+	.scan_fd          = nl80211_scan_fd,
+	.scan_poll        = nl80211_scan_poll,
+	.scan_free        = nl80211_scan_free,
 	.close            = nl80211_close
 };
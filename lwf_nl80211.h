@@ -25,21 +25,167 @@
 #include <string.h>
 #include <dirent.h>
 #include <signal.h>
+#include <stdbool.h>
 #include <sys/un.h>
 #include <netlink/netlink.h>
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
 #include <netlink/genl/ctrl.h>
+#include <linux/rtnetlink.h>
 
 #include "lwf.h"
 #include "lwf/utils.h"
 #include "api/nl80211.h"
 
+#define NL80211_WIPHY_BANDS	8
+
+struct nl80211_wiphy_band {
+	uint8_t present;
+	uint8_t has_vht;
+	uint16_t ht_caps;
+	uint32_t vht_caps;
+};
+
+struct nl80211_wiphy_freq {
+	uint32_t mhz;
+	uint32_t flags;
+	int16_t max_txpower;
+	uint8_t band;
+	uint8_t disabled:1;
+	uint8_t restricted:1;
+};
+
+struct nl80211_wiphy_info {
+	struct nl80211_wiphy_info *next;
+	int phyidx;
+	char name[32];
+	bool ok;
+	uint32_t hwmodes;
+	uint32_t htmodes;
+	uint32_t feature_flags;
+	int mbssid;
+	struct nl80211_wiphy_band bands[NL80211_WIPHY_BANDS];
+	struct nl80211_wiphy_freq *freqs;
+	int freqs_count;
+	int freqs_size;
+};
+
+#define NL80211_MCAST_GROUPS	16
+#define NL80211_MSG_POOL		8
+
+struct nl80211_mcast_group {
+	char name[GENL_NAMSIZ];
+	int id;
+	bool wait_joined;
+};
+
+struct nl80211_link {
+	struct nl80211_link *next;
+	char ifname[IFNAMSIZ];
+	int ifindex;
+	int phyidx;
+	uint32_t iftype;
+	char phyname[32];
+};
+
+struct nl80211_sta_node {
+	struct nl80211_sta_node *next;
+	struct lwf_assoclist_entry e;
+};
+
+struct nl80211_sta_watch {
+	struct nl80211_sta_watch *next;
+	char ifname[IFNAMSIZ];
+	void (*cb)(const struct lwf_station_notify *, void *);
+	void *ctx;
+	struct nl80211_sta_node *stations;
+};
+
+struct nl80211_hw_node {
+	struct nl80211_hw_node *next;
+	char ifname[IFNAMSIZ];
+	unsigned int ifindex;
+	int err;
+	struct lwf_hardware_id id;
+	const struct lwf_hardware_entry *entry;
+};
+
+struct nl80211_async_req {
+	struct nl80211_async_req *next;
+	struct nl_msg *msg;
+	uint32_t seq;
+	bool dump;
+	int (*cb)(struct nl_msg *, void *);
+	void *cb_arg;
+	void (*done)(int, void *);
+	void *arg;
+};
+
+struct nl80211_batch;
+
+struct nl80211_batch_req {
+	struct nl80211_batch_req *next;
+	struct nl80211_batch *batch;
+	int err;
+};
+
+struct nl80211_batch {
+	struct nl80211_batch_req *reqs;
+	int pending;
+};
+
+struct nl80211_scan {
+	struct nl80211_scan *next;
+	char ifname[IFNAMSIZ];
+	int ifidx;
+	int phyidx;
+	bool busy;
+	int64_t deadline;
+	int event;
+	int result;
+	void (*cb)(const struct lwf_scanlist_entry *, void *);
+	void *ctx;
+};
+
+struct nl80211_scan_done {
+	struct nl80211_scan_done *next;
+	int phyidx;
+	int64_t ts;
+};
+
 struct nl80211_state {
 	struct nl_sock *nl_sock;
-	struct nl_cache *nl_cache;
-	struct genl_family *nl80211;
-	struct genl_family *nlctrl;
+	int nl80211_id;
+	struct nl80211_mcast_group groups[NL80211_MCAST_GROUPS];
+	int groups_count;
+	struct nl_sock *nl_event;
+	struct nl_cb *nl_event_cb;
+	struct nl_sock *nl_wait;
+	struct nl_cb *nl_wait_cb;
+	uint32_t features;
+	bool features_valid;
+	struct nl80211_wiphy_info *wiphy;
+	struct nl80211_wiphy_info *wiphy_tmp;
+	struct nl80211_sta_watch *sta_watch;
+	struct nl_sock *nl_mlme;
+	struct nl_cb *nl_mlme_cb;
+	int mlme_group;
+	struct nl_sock *nl_async;
+	struct nl_cb *nl_async_cb;
+	struct nl80211_async_req *async;
+	bool async_dump;
+	struct nl_sock *nl_route;
+	struct nl_cb *nl_route_cb;
+	struct nl80211_link *links;
+	bool links_valid;
+	struct nl_msg *msg_pool[NL80211_MSG_POOL];
+	int msg_pool_count;
+	struct nl_cb *cb_pool;
+	bool cb_pool_busy;
+	int cb_pool_err;
+	struct nl80211_summary_node *summaries;
+	struct nl80211_scan *scans;
+	struct nl80211_scan_done *scan_done;
 };
 
 struct nl80211_msg_conveyor {
@@ -49,6 +195,8 @@ struct nl80211_msg_conveyor {
 
 struct nl80211_event_conveyor {
 	uint32_t wait[(NL80211_CMD_MAX / 32) + !!(NL80211_CMD_MAX % 32)];
+	int ifidx;
+	int phyidx;
 	int recv;
 };
 
@@ -57,16 +205,39 @@ struct nl80211_group_conveyor {
 	int id;
 };
 
-struct nl80211_rssi_rate {
-	int16_t rate;
-	int rate_samples;
-	int8_t  rssi;
-	int rssi_samples;
+struct nl80211_scan_out {
+	struct lwf_buf *b;
+	uint32_t info;
+	bool v2;
+};
+
+struct nl80211_ie_ctx {
+	struct lwf_scanlist_entry *e;
+	struct lwf_scanlist_entry_v2 *x;
+	uint32_t info;
+};
+
+struct nl80211_ie_handler {
+	uint8_t min_len;
+	uint32_t info;
+	void (*parse)(struct nl80211_ie_ctx *, const uint8_t *, int);
+};
+
+struct nl80211_sta_summary {
+	struct lwf_station_summary s;
+	double mw_sum;
+	int64_t tx_sum;
+	int64_t rx_sum;
+	int tx_samples;
+	int rx_samples;
+	struct lwf_buf signals;
 };
 
-struct nl80211_array_buf {
-	void *buf;
-	int count;
+struct nl80211_summary_node {
+	struct nl80211_summary_node *next;
+	char ifname[IFNAMSIZ];
+	int64_t ts;
+	struct lwf_station_summary s;
 };
 
 #endif
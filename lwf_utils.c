@@ -20,16 +20,21 @@
  * inspired by the hostapd madwifi driver.
  */
 
+#include <pthread.h>
+
 #include "lwf/utils.h"
 
 
-static int ioctl_socket = -1;
+static __thread int ioctl_socket = -1;
 
 static int lwf_ioctl_socket(void)
 {
 	/* Prepare socket */
 	if (ioctl_socket == -1)
 	{
+		/* registers the thread for cleanup of its default context */
+		lwf_ctx_get();
+
 		ioctl_socket = socket(AF_INET, SOCK_DGRAM, 0);
 		fcntl(ioctl_socket, F_SETFD, fcntl(ioctl_socket, F_GETFD) | FD_CLOEXEC);
 	}
@@ -128,47 +133,198 @@ void lwf_close(void)
 	ioctl_socket = -1;
 }
 
-struct lwf_hardware_entry * lwf_hardware(struct lwf_hardware_id *id)
+uint64_t lwf_counter_update(struct lwf_counter *c, uint64_t sample)
+{
+	if (!c->bits || c->bits > 64)
+		c->bits = 64;
+
+	if (!c->valid)
+	{
+		c->total = sample;
+		c->valid = 1;
+	}
+	else
+	{
+		c->total += lwf_counter_delta(c->last, sample, c->bits);
+	}
+
+	c->last = sample;
+
+	return c->total;
+}
+
+void * lwf_buf_add(struct lwf_buf *b, int len)
+{
+	int size;
+	char *p;
+
+	if (b->len + len > b->size)
+	{
+		if (!b->grow)
+		{
+			b->len += len;
+			return NULL;
+		}
+
+		for (size = b->size ? b->size : 16 * len; size < b->len + len; size *= 2);
+
+		/* out of memory is no overflow, leave len consistent with buf */
+		if (!(p = realloc(b->buf, size)))
+			return NULL;
+
+		b->buf = p;
+		b->size = size;
+	}
+
+	p = b->buf + b->len;
+	b->len += len;
+
+	return p;
+}
+
+void lwf_buf_free(struct lwf_buf *b)
+{
+	if (b->grow)
+		free(b->buf);
+
+	b->buf = NULL;
+	b->size = 0;
+	b->len = 0;
+}
+
+/*
+ * The hardware database is parsed once into an array sorted by id tuple.
+ * Wildcard fields (0xffff) are stored as-is, so a lookup probes every
+ * combination of exact and wildcard fields by binary search and picks the
+ * match listed first in the file, like the old linear scan did.
+ */
+struct lwf_hardware_slot {
+	struct lwf_hardware_entry e;
+	int line;
+};
+
+static struct lwf_hardware_slot *hwdb;
+static int hwdb_count;
+static pthread_once_t hwdb_once = PTHREAD_ONCE_INIT;
+
+static int lwf_hardware_idcmp(const struct lwf_hardware_slot *sa,
+                              const struct lwf_hardware_slot *sb)
+{
+	if (sa->e.vendor_id != sb->e.vendor_id)
+		return sa->e.vendor_id - sb->e.vendor_id;
+
+	if (sa->e.device_id != sb->e.device_id)
+		return sa->e.device_id - sb->e.device_id;
+
+	if (sa->e.subsystem_vendor_id != sb->e.subsystem_vendor_id)
+		return sa->e.subsystem_vendor_id - sb->e.subsystem_vendor_id;
+
+	if (sa->e.subsystem_device_id != sb->e.subsystem_device_id)
+		return sa->e.subsystem_device_id - sb->e.subsystem_device_id;
+
+	return 0;
+}
+
+static int lwf_hardware_cmp(const void *a, const void *b)
+{
+	const struct lwf_hardware_slot *sa = a, *sb = b;
+	int rv = lwf_hardware_idcmp(sa, sb);
+
+	return rv ? rv : sa->line - sb->line;
+}
+
+static void lwf_hardware_load(void)
 {
 	FILE *db;
 	char buf[256] = { 0 };
-	static struct lwf_hardware_entry e;
-	struct lwf_hardware_entry *rv = NULL;
+	struct lwf_hardware_slot *tmp, *slot;
+	int line = 0, size = 0;
 
 	if (!(db = fopen(LWF_HARDWARE_FILE, "r")))
-		return NULL;
+		return;
 
 	while (fgets(buf, sizeof(buf) - 1, db) != NULL)
 	{
-		memset(&e, 0, sizeof(e));
+		if (hwdb_count >= size)
+		{
+			size = size ? size * 2 : 64;
+			tmp = realloc(hwdb, size * sizeof(*hwdb));
+
+			if (!tmp)
+				break;
+
+			hwdb = tmp;
+		}
+
+		slot = &hwdb[hwdb_count];
+		memset(slot, 0, sizeof(*slot));
 
 		if (sscanf(buf, "%hx %hx %hx %hx %hd %hd \"%63[^\"]\" \"%63[^\"]\"",
-			       &e.vendor_id, &e.device_id,
-			       &e.subsystem_vendor_id, &e.subsystem_device_id,
-			       &e.txpower_offset, &e.frequency_offset,
-			       e.vendor_name, e.device_name) < 8)
+			       &slot->e.vendor_id, &slot->e.device_id,
+			       &slot->e.subsystem_vendor_id, &slot->e.subsystem_device_id,
+			       &slot->e.txpower_offset, &slot->e.frequency_offset,
+			       slot->e.vendor_name, slot->e.device_name) < 8)
 			continue;
 
-		if ((e.vendor_id != 0xffff) && (e.vendor_id != id->vendor_id))
-			continue;
+		slot->line = line++;
+		hwdb_count++;
+	}
 
-		if ((e.device_id != 0xffff) && (e.device_id != id->device_id))
-			continue;
+	fclose(db);
 
-		if ((e.subsystem_vendor_id != 0xffff) &&
-			(e.subsystem_vendor_id != id->subsystem_vendor_id))
-			continue;
+	qsort(hwdb, hwdb_count, sizeof(*hwdb), lwf_hardware_cmp);
+}
 
-		if ((e.subsystem_device_id != 0xffff) &&
-			(e.subsystem_device_id != id->subsystem_device_id))
-			continue;
+/* Find the first slot with the given id tuple, i.e. the lowest line */
+static struct lwf_hardware_slot * lwf_hardware_find(uint16_t vid, uint16_t did,
+                                                    uint16_t svid, uint16_t sdid)
+{
+	struct lwf_hardware_slot key = {
+		.e.vendor_id = vid,
+		.e.device_id = did,
+		.e.subsystem_vendor_id = svid,
+		.e.subsystem_device_id = sdid,
+		.line = -1
+	};
+	int lo = 0, hi = hwdb_count;
+
+	while (lo < hi)
+	{
+		int mid = lo + (hi - lo) / 2;
 
-		rv = &e;
-		break;
+		if (lwf_hardware_cmp(&hwdb[mid], &key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
 
-	fclose(db);
-	return rv;
+	if (lo < hwdb_count && !lwf_hardware_idcmp(&hwdb[lo], &key))
+		return &hwdb[lo];
+
+	return NULL;
+}
+
+struct lwf_hardware_entry * lwf_hardware(struct lwf_hardware_id *id)
+{
+	struct lwf_hardware_slot *slot, *rv = NULL;
+	int i;
+
+	pthread_once(&hwdb_once, lwf_hardware_load);
+
+	/* bit n set selects the wildcard for the n-th id field */
+	for (i = 0; i < 16; i++)
+	{
+		slot = lwf_hardware_find(
+			(i & 1) ? 0xffff : id->vendor_id,
+			(i & 2) ? 0xffff : id->device_id,
+			(i & 4) ? 0xffff : id->subsystem_vendor_id,
+			(i & 8) ? 0xffff : id->subsystem_device_id);
+
+		if (slot && (!rv || slot->line < rv->line))
+			rv = slot;
+	}
+
+	return rv ? &rv->e : NULL;
 }
 
 int lwf_hardware_id_from_mtd(struct lwf_hardware_id *id)